@@ -0,0 +1,151 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifyQueue.h"
+#include "HAL/CriticalSection.h"
+#include "UObject/Interface.h"
+#include "UObject/WeakObjectPtr.h"
+#include "Engine/EngineBaseTypes.h"
+
+#include "AnimNotifyBatchDispatcher.generated.h"
+
+class UWorld;
+class UAnimInstance;
+class USkeletalMeshComponent;
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UAnimNotifyWorkerThreadSafe : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+* Interface for anim notifies (UAnimNotify or UAnimNotifyState subclasses) whose handler is safe to run on an
+* animation worker thread. When FAnimNotifyBatchDispatcher::bDeliverThreadSafeNotifiesOnWorker is set, these are
+* delivered directly from the evaluation task instead of being queued for the game thread.
+* Implemented natively only: the test is Implements<UAnimNotifyWorkerThreadSafe>(), a class data lookup that is safe
+* on workers, since the engine is built without RTTI.
+**/
+class IAnimNotifyWorkerThreadSafe
+{
+	GENERATED_BODY()
+
+public:
+
+	//Called on the worker thread that evaluated InComponent. Must not touch game thread state
+	virtual void NotifyOnWorker(USkeletalMeshComponent* InComponent, const FAnimNotifyEventReference& InEvent) = 0;
+};
+
+/** Per-frame statistics of FAnimNotifyBatchDispatcher */
+struct FAnimNotifyBatchStats
+{
+	//Notifies queued by evaluation tasks this frame
+	int32 NumQueued = 0;
+
+	//Notifies delivered on the game thread in the batch
+	int32 NumDispatched = 0;
+
+	//Notifies delivered directly on worker threads
+	int32 NumDispatchedOnWorker = 0;
+
+	//Distinct target components in the batch
+	int32 NumTargets = 0;
+
+	//Game thread time spent in DispatchBatch_GameThread
+	double DispatchTimeMs = 0.0;
+};
+
+class FAnimNotifyBatchDispatcher;
+
+/**
+* Runs FAnimNotifyBatchDispatcher::DispatchBatch_GameThread on the game thread. Every component using batched
+* dispatch has its PrimaryComponentTick as a prerequisite (added in AddComponent), and a component tick does not
+* complete before its parallel evaluation task, so every notify of the frame is queued when it runs. Registered in
+* TG_PrePhysics; the task graph delays it to the latest tick group among its prerequisites.
+**/
+struct FAnimNotifyBatchTickFunction : public FTickFunction
+{
+	FAnimNotifyBatchDispatcher* Dispatcher = nullptr;
+
+	//~ Begin FTickFunction Interface
+	ENGINE_API virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	ENGINE_API virtual FString DiagnosticMessage() override;
+	//~ End FTickFunction Interface
+};
+
+/**
+* World-level collector for anim notifies produced during parallel animation evaluation.
+*
+* Each worker thread appends to its own buffer, so queueing takes no lock and never contends. Buffers are created once
+* per thread (the only locked step). After all evaluation tasks of the frame are complete the game thread merges the
+* buffers, sorts the notifies by target component (stable, so per-component order is preserved) and dispatches them in
+* one pass. This replaces the per-component ConditionallyDispatchQueuedAnimEvents round trips.
+**/
+class FAnimNotifyBatchDispatcher
+{
+public:
+	struct FQueuedNotify
+	{
+		//Weak so DispatchBatch_GameThread can skip targets destroyed since queueing
+		TWeakObjectPtr<USkeletalMeshComponent> Target;
+		TWeakObjectPtr<UAnimInstance> Instance;
+		FAnimNotifyEventReference Event;
+	};
+
+	//Get (and create on first use) the dispatcher of a world. Owned by USkeletalMeshWorldSubsystem
+	static ENGINE_API FAnimNotifyBatchDispatcher* Get(UWorld* InWorld);
+
+	/**
+	* Start batching a component's notifies: adds its PrimaryComponentTick as a prerequisite of DispatchTickFunction,
+	* registering the tick function with the first component. Game thread
+	**/
+	ENGINE_API void AddComponent(USkeletalMeshComponent* InComponent);
+
+	//Stop batching a component's notifies; unregisters DispatchTickFunction with the last component. Game thread
+	ENGINE_API void RemoveComponent(USkeletalMeshComponent* InComponent);
+
+	/**
+	* Queue a notify from any thread. Delivers it immediately instead if bDeliverThreadSafeNotifiesOnWorker is set and
+	* the notify's class Implements<UAnimNotifyWorkerThreadSafe>() (called through Cast<IAnimNotifyWorkerThreadSafe>).
+	**/
+	ENGINE_API void Queue_AnyThread(USkeletalMeshComponent* InTarget, UAnimInstance* InInstance, const FAnimNotifyEventReference& InEvent);
+
+	/**
+	* Merge all worker buffers and dispatch the batch. Called once per frame on the game thread by DispatchTickFunction,
+	* once every registered component's ParallelAnimationEvaluationTask has completed. Targets destroyed since queueing
+	* are skipped.
+	**/
+	ENGINE_API void DispatchBatch_GameThread();
+
+	FAnimNotifyBatchTickFunction DispatchTickFunction;
+
+	//Stats of the last dispatched frame
+	const FAnimNotifyBatchStats& GetLastFrameStats() const { return LastFrameStats; }
+
+	//Deliver IAnimNotifyWorkerThreadSafe notifies on the worker that evaluated them
+	bool bDeliverThreadSafeNotifiesOnWorker = false;
+
+private:
+	struct FWorkerBuffer
+	{
+		TArray<FQueuedNotify> Notifies;
+		int32 NumDispatchedOnWorker = 0;
+	};
+
+	//Buffer of the calling thread, created on first use
+	ENGINE_API FWorkerBuffer& GetThreadBuffer();
+
+	//Guards WorkerBuffers growth only, never held while queueing
+	FCriticalSection WorkerBuffersLock;
+	TArray<TUniquePtr<FWorkerBuffer>> WorkerBuffers;
+
+	//Components whose ticks are prerequisites of DispatchTickFunction
+	int32 NumComponents = 0;
+
+	//Scratch storage for the merged batch, kept to avoid per-frame allocations
+	TArray<FQueuedNotify> MergedNotifies;
+
+	FAnimNotifyBatchStats LastFrameStats;
+};
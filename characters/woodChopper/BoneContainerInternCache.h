@@ -0,0 +1,106 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "BoneContainer.h"
+
+class USkeletalMesh;
+class USkeleton;
+
+/** Identity of an interned bone container */
+struct FBoneContainerInternKey
+{
+	TObjectKey<USkeletalMesh> SkeletalMesh;
+	TObjectKey<USkeleton> Skeleton;
+	int32 LODIndex = 0;
+
+	//Hash of the curve filter settings the container was built with
+	uint32 CurveFilterHash = 0;
+
+	bool operator==(const FBoneContainerInternKey& Other) const
+	{
+		return SkeletalMesh == Other.SkeletalMesh && Skeleton == Other.Skeleton && LODIndex == Other.LODIndex && CurveFilterHash == Other.CurveFilterHash;
+	}
+
+	friend uint32 GetTypeHash(const FBoneContainerInternKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.SkeletalMesh), GetTypeHash(Key.Skeleton));
+		return HashCombine(HashCombine(Hash, ::GetTypeHash(Key.LODIndex)), Key.CurveFilterHash);
+	}
+};
+
+/** What the intern cache saved, for memreport and the 'stat' overlay */
+struct FBoneContainerInternStats
+{
+	//Distinct containers built
+	int32 NumContainers = 0;
+
+	//References handed out, one per component and LOD change
+	int32 NumReferences = 0;
+
+	//Bytes of containers that would exist without interning minus bytes that do
+	SIZE_T BytesReclaimed = 0;
+
+	//Build time avoided by cache hits (hits times the average build time)
+	double BuildTimeSavedMs = 0.0;
+};
+
+/**
+* Process-wide cache of immutable FBoneContainers shared by every component with the same mesh, skeleton, LOD and
+* curve filter. A hundred identical characters hold one container instead of a hundred.
+*
+* Entries are held weakly: a container lives as long as some component references it. Entries whose container has
+* expired are pruned on every miss and in Invalidate, so Entries does not grow with every configuration ever seen.
+* When a mesh or skeleton is modified the entries built from it are dropped and components rebuild once on their next
+* required bones update.
+*
+* Interned containers are never written. The anim instance proxy writes its bone container in RecalcRequiredBones
+* (InitializeTo) and through SetUseRAWData; it must first take a private copy with
+* USkeletalMeshComponent::GetWritableRequiredBones (copy-on-write, see MakeWritableCopy) and write that instead.
+**/
+class FBoneContainerInternCache
+{
+public:
+	/**
+	* Get the shared container for a key, building it with InBuild on a miss. Thread safe; concurrent misses on one key
+	* build once
+	**/
+	static ENGINE_API TSharedPtr<const FBoneContainer> FindOrBuild(const FBoneContainerInternKey& InKey, TFunctionRef<void(FBoneContainer&)> InBuild);
+
+	//Drop every entry built from InAsset (a skeletal mesh or a skeleton), and every expired entry
+	static ENGINE_API void Invalidate(const UObject* InAsset);
+
+	//Copy-on-write: a private, writable copy of an interned container, which stops sharing with the cache
+	static TSharedPtr<FBoneContainer> MakeWritableCopy(const TSharedPtr<const FBoneContainer>& InInterned)
+	{
+		return InInterned.IsValid() ? MakeShared<FBoneContainer>(*InInterned) : MakeShared<FBoneContainer>();
+	}
+
+	static ENGINE_API FBoneContainerInternStats GetStats();
+
+private:
+	struct FEntry
+	{
+		TWeakPtr<const FBoneContainer> Container;
+		SIZE_T AllocatedSize = 0;
+		double BuildTimeMs = 0.0;
+		int32 NumHits = 0;
+	};
+
+	static ENGINE_API FRWLock Lock;
+	static ENGINE_API TMap<FBoneContainerInternKey, FEntry> Entries;
+
+	//Remove entries whose container no longer has any reference. Lock must be held for writing
+	static void PruneExpired_Locked()
+	{
+		for (TMap<FBoneContainerInternKey, FEntry>::TIterator It = Entries.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().Container.IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+};
@@ -0,0 +1,98 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Update order for the linked anim instances of one component.
+*
+* Instances are grouped into waves: every instance in a wave only depends on instances of earlier waves, and waves run
+* one after the other. The game thread update (NativeUpdateAnimation / BlueprintUpdateAnimation) walks Order serially,
+* which respects the dependencies; only the proxy update inside the component's evaluation task, which is thread safe,
+* runs a wave in parallel (ParallelFor). Within a wave instances keep their LinkedInstances order, and results are
+* merged in that order, so the outcome does not depend on which worker finished first.
+**/
+struct FLinkedInstanceSchedule
+{
+	//Instance indices (into LinkedInstances) grouped by wave
+	TArray<int32> Order;
+
+	//Start of each wave in Order, plus a final entry equal to Order.Num()
+	TArray<int32> WaveStarts;
+
+	int32 NumWaves() const { return FMath::Max(WaveStarts.Num() - 1, 0); }
+
+	TArrayView<const int32> GetWave(int32 InWave) const
+	{
+		return TArrayView<const int32>(Order.GetData() + WaveStarts[InWave], WaveStarts[InWave + 1] - WaveStarts[InWave]);
+	}
+
+	/**
+	* Build the waves.
+	* @param InNumInstances: Number of linked instances
+	* @param InDependencies: (Instance, DependsOn) pairs, e.g. a layer reading the output of the graph that hosts it
+	* @return false if the dependencies contain a cycle; the schedule then degrades to one instance per wave in index order
+	**/
+	bool Build(int32 InNumInstances, TArrayView<const TPair<int32, int32>> InDependencies)
+	{
+		Order.Reset();
+		WaveStarts.Reset();
+
+		TArray<int32> NumPending;
+		NumPending.SetNumZeroed(InNumInstances);
+		TArray<TArray<int32, TInlineAllocator<4>>> Dependents;
+		Dependents.SetNum(InNumInstances);
+		for (const TPair<int32, int32>& Dependency : InDependencies)
+		{
+			++NumPending[Dependency.Key];
+			Dependents[Dependency.Value].Add(Dependency.Key);
+		}
+
+		TArray<int32> Wave;
+		for (int32 Index = 0; Index < InNumInstances; ++Index)
+		{
+			if (NumPending[Index] == 0)
+			{
+				Wave.Add(Index);
+			}
+		}
+
+		TArray<int32> NextWave;
+		while (Wave.Num() > 0)
+		{
+			WaveStarts.Add(Order.Num());
+			Order.Append(Wave);
+
+			NextWave.Reset();
+			for (int32 Index : Wave)
+			{
+				for (int32 Dependent : Dependents[Index])
+				{
+					if (--NumPending[Dependent] == 0)
+					{
+						NextWave.Add(Dependent);
+					}
+				}
+			}
+			NextWave.Sort();
+			Swap(Wave, NextWave);
+		}
+
+		if (Order.Num() != InNumInstances)
+		{
+			Order.Reset();
+			WaveStarts.Reset();
+			for (int32 Index = 0; Index < InNumInstances; ++Index)
+			{
+				WaveStarts.Add(Index);
+				Order.Add(Index);
+			}
+			WaveStarts.Add(InNumInstances);
+			return false;
+		}
+
+		WaveStarts.Add(Order.Num());
+		return true;
+	}
+};
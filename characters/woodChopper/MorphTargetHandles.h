@@ -0,0 +1,133 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+#include "Animation/MorphTarget.h"
+
+/**
+* Resolved reference to a morph target of the component's current skeletal mesh.
+* Resolve once with USkeletalMeshComponent::FindMorphTargetHandle. Handles go stale when the mesh changes and then
+* resolve to nothing rather than to a different morph target.
+**/
+struct FMorphTargetHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+};
+
+/**
+* Dense morph target weights for one component, indexed by the morph target's index on the mesh.
+* The set of non-zero weights is kept as a compact index list so skinning only visits active morphs,
+* and add/remove are O(1) (swap-remove through ActiveSlot).
+**/
+struct FMorphTargetWeights
+{
+	//Weight per mesh morph target
+	TArray<float> Weights;
+
+	//Indices of morph targets currently in the active set
+	TArray<int32> ActiveIndices;
+
+	//Position of each morph target in ActiveIndices, INDEX_NONE when inactive
+	TArray<int32> ActiveSlot;
+
+	void Init(int32 InNumMorphTargets)
+	{
+		Weights.Init(0.f, InNumMorphTargets);
+		ActiveSlot.Init(INDEX_NONE, InNumMorphTargets);
+		ActiveIndices.Reset();
+	}
+
+	/**
+	* Set a weight and update the active set.
+	* @param InThreshold: Weights with an absolute value at or below this are culled from the active set
+	* @param bRemoveZeroWeight: If false, a culled weight stays in the active set (editor use, see SetMorphTarget)
+	**/
+	void Set(int32 InIndex, float InWeight, float InThreshold, bool bRemoveZeroWeight = true)
+	{
+		if (!Weights.IsValidIndex(InIndex))
+		{
+			return;
+		}
+		Weights[InIndex] = InWeight;
+
+		const bool bActive = FMath::Abs(InWeight) > InThreshold || !bRemoveZeroWeight;
+		if (bActive && ActiveSlot[InIndex] == INDEX_NONE)
+		{
+			ActiveSlot[InIndex] = ActiveIndices.Add(InIndex);
+		}
+		else if (!bActive && ActiveSlot[InIndex] != INDEX_NONE)
+		{
+			const int32 Slot = ActiveSlot[InIndex];
+			ActiveIndices.RemoveAtSwap(Slot, EAllowShrinking::No);
+			if (ActiveIndices.IsValidIndex(Slot))
+			{
+				ActiveSlot[ActiveIndices[Slot]] = Slot;
+			}
+			ActiveSlot[InIndex] = INDEX_NONE;
+		}
+	}
+
+	float Get(int32 InIndex) const
+	{
+		return Weights.IsValidIndex(InIndex) ? Weights[InIndex] : 0.f;
+	}
+
+	void Clear()
+	{
+		for (int32 Index : ActiveIndices)
+		{
+			Weights[Index] = 0.f;
+			ActiveSlot[Index] = INDEX_NONE;
+		}
+		ActiveIndices.Reset();
+	}
+};
+
+/** Active morph target set for one LOD, as reported by USkeletalMeshComponent::GetActiveMorphTargetsForLOD */
+struct FMorphTargetLODActiveSet
+{
+	int32 LODIndex = INDEX_NONE;
+
+	//Morph targets with a weight above the threshold that have deltas in this LOD
+	TArray<int32> ActiveIndices;
+
+	//Total number of vertex deltas that will be applied for this LOD
+	int32 NumDeltas = 0;
+};
+
+namespace MorphTargetDeltas
+{
+	/**
+	* Apply the sparse position and normal deltas of one morph target to CPU-skinned vertex data.
+	* Only the vertices listed in InDeltas are touched. Each delta is a single vector multiply-add.
+	* @param InDeltas: Sparse deltas of one morph target LOD
+	* @param InWeight: Morph target weight
+	* @param InOutPositions: Positions to morph, indexed by FMorphTargetDelta::SourceIdx
+	* @param InOutTangentZ: Normals to morph (may be empty to skip normals)
+	**/
+	inline void ApplyWeighted(TArrayView<const FMorphTargetDelta> InDeltas, float InWeight, TArrayView<FVector3f> InOutPositions, TArrayView<FVector3f> InOutTangentZ)
+	{
+		const VectorRegister4Float Weight = VectorSetFloat1(InWeight);
+		const bool bApplyNormals = InOutTangentZ.Num() > 0;
+
+		for (const FMorphTargetDelta& Delta : InDeltas)
+		{
+			const uint32 Vertex = Delta.SourceIdx;
+			checkSlow(InOutPositions.IsValidIndex(Vertex));
+
+			FVector3f& Position = InOutPositions[Vertex];
+			VectorStoreFloat3(VectorMultiplyAdd(VectorLoadFloat3(&Delta.PositionDelta), Weight, VectorLoadFloat3(&Position)), &Position);
+
+			if (bApplyNormals)
+			{
+				FVector3f& TangentZ = InOutTangentZ[Vertex];
+				VectorStoreFloat3(VectorMultiplyAdd(VectorLoadFloat3(&Delta.TangentZDelta), Weight, VectorLoadFloat3(&TangentZ)), &TangentZ);
+			}
+		}
+	}
+}
@@ -0,0 +1,102 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UPhysicsAsset;
+
+/**
+* Immutable open-addressing FName -> index table.
+* Built once from a list of names, lookups are a hash plus a short linear probe over a power-of-two table.
+* When a name appears more than once the first index wins, matching the linear scans it replaces.
+**/
+class FNameIndexMap
+{
+public:
+	void Build(TArrayView<const FName> InNames)
+	{
+		const int32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(InNames.Num() * 2, 4));
+		Mask = Capacity - 1;
+		Keys.Init(NAME_None, Capacity);
+		Values.Init(INDEX_NONE, Capacity);
+
+		for (int32 Index = 0; Index < InNames.Num(); ++Index)
+		{
+			const FName Name = InNames[Index];
+			if (Name.IsNone())
+			{
+				continue;
+			}
+			uint32 Slot = GetTypeHash(Name) & Mask;
+			while (Values[Slot] != INDEX_NONE && Keys[Slot] != Name)
+			{
+				Slot = (Slot + 1) & Mask;
+			}
+			if (Values[Slot] == INDEX_NONE)
+			{
+				Keys[Slot] = Name;
+				Values[Slot] = Index;
+			}
+		}
+	}
+
+	int32 Find(FName InName) const
+	{
+		if (Values.Num() == 0 || InName.IsNone())
+		{
+			return INDEX_NONE;
+		}
+		uint32 Slot = GetTypeHash(InName) & Mask;
+		while (Values[Slot] != INDEX_NONE)
+		{
+			if (Keys[Slot] == InName)
+			{
+				return Values[Slot];
+			}
+			Slot = (Slot + 1) & Mask;
+		}
+		return INDEX_NONE;
+	}
+
+private:
+	TArray<FName> Keys;
+	TArray<int32> Values;
+	uint32 Mask = 0;
+};
+
+/** Name lookup tables for one physics asset: body setup bone names and constraint joint names */
+struct FPhysicsAssetNameIndex
+{
+	FNameIndexMap Bodies;
+	FNameIndexMap Constraints;
+
+	//Get (building on first request) the shared index for a physics asset
+	static ENGINE_API TSharedPtr<const FPhysicsAssetNameIndex> Get(const UPhysicsAsset* InPhysicsAsset);
+
+	//Drop the cached index, called when the physics asset is edited or destroyed
+	static ENGINE_API void Invalidate(const UPhysicsAsset* InPhysicsAsset);
+};
+
+/**
+* Resolved reference to an entry of USkeletalMeshComponent::Bodies.
+* Resolve once with FindBodyHandle and reuse every frame. A handle goes stale when the component re-creates its
+* physics state; stale handles resolve to nullptr rather than to a different body.
+**/
+struct FBodyHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+};
+
+/** Resolved reference to an entry of USkeletalMeshComponent::Constraints, with the same lifetime rules as FBodyHandle */
+struct FConstraintHandle
+{
+	int32 Index = INDEX_NONE;
+	uint32 Serial = 0;
+
+	bool IsSet() const { return Index != INDEX_NONE; }
+};
@@ -0,0 +1,141 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UPhysicsAsset;
+class USkeletalMesh;
+
+/**
+* Depth-first ordering of the bodies of a physics asset on a given skeletal mesh.
+* The bodies attached to the subtree of any bone occupy the contiguous slice [Begin, End) of BodyOrder, with the
+* bone's own body (if it has one) first. This turns every "all bodies below" operation into a linear pass.
+**/
+struct FPhysicsAssetSubtreeRanges
+{
+	struct FRange
+	{
+		int32 Begin = 0;
+		int32 End = 0;
+
+		int32 Num() const { return End - Begin; }
+	};
+
+	//Body indices (into the physics asset / USkeletalMeshComponent::Bodies) in depth-first order
+	TArray<int32> BodyOrder;
+
+	//Subtree range per mesh bone index
+	TArray<FRange> BoneRanges;
+
+	//Whether the mesh bone has a body of its own (stored at BoneRanges[Bone].Begin)
+	TBitArray<> BoneHasBody;
+
+	bool IsValidBone(int32 InBoneIndex) const { return BoneRanges.IsValidIndex(InBoneIndex); }
+
+	/**
+	* Bodies in the subtree rooted at InBoneIndex
+	* @param bIncludeSelf: Whether the body of InBoneIndex itself is part of the result
+	**/
+	TArrayView<const int32> GetBodiesBelow(int32 InBoneIndex, bool bIncludeSelf) const
+	{
+		if (!IsValidBone(InBoneIndex))
+		{
+			return TArrayView<const int32>();
+		}
+		const FRange& Range = BoneRanges[InBoneIndex];
+		const int32 Begin = (!bIncludeSelf && BoneHasBody[InBoneIndex]) ? Range.Begin + 1 : Range.Begin;
+		return TArrayView<const int32>(BodyOrder.GetData() + Begin, Range.End - Begin);
+	}
+
+	/**
+	* Build the ordering.
+	* @param InParentIndices: Parent bone index per mesh bone (INDEX_NONE for roots), parents before children as in FReferenceSkeleton
+	* @param InBoneToBody: Body index per mesh bone, INDEX_NONE if the bone has no body
+	**/
+	void Build(TArrayView<const int32> InParentIndices, TArrayView<const int32> InBoneToBody)
+	{
+		const int32 NumBones = InParentIndices.Num();
+		check(InBoneToBody.Num() == NumBones);
+
+		BodyOrder.Reset();
+		BoneRanges.SetNumZeroed(NumBones);
+		BoneHasBody.Init(false, NumBones);
+
+		//Children as a flattened adjacency list (counting sort keeps sibling order stable)
+		TArray<int32> FirstChild;
+		FirstChild.SetNumZeroed(NumBones + 1);
+		for (int32 Bone = 0; Bone < NumBones; ++Bone)
+		{
+			if (InParentIndices[Bone] != INDEX_NONE)
+			{
+				++FirstChild[InParentIndices[Bone] + 1];
+			}
+		}
+		for (int32 Bone = 0; Bone < NumBones; ++Bone)
+		{
+			FirstChild[Bone + 1] += FirstChild[Bone];
+		}
+		TArray<int32> Children;
+		Children.SetNumUninitialized(FirstChild[NumBones]);
+		TArray<int32> Cursor(FirstChild);
+		for (int32 Bone = 0; Bone < NumBones; ++Bone)
+		{
+			if (InParentIndices[Bone] != INDEX_NONE)
+			{
+				Children[Cursor[InParentIndices[Bone]]++] = Bone;
+			}
+		}
+
+		//Iterative depth-first walk, a negative entry on the stack closes the subtree of ~Entry
+		TArray<int32> Stack;
+		for (int32 Root = NumBones - 1; Root >= 0; --Root)
+		{
+			if (InParentIndices[Root] == INDEX_NONE)
+			{
+				Stack.Push(Root);
+			}
+		}
+		while (Stack.Num() > 0)
+		{
+			const int32 Entry = Stack.Pop(EAllowShrinking::No);
+			if (Entry < 0)
+			{
+				BoneRanges[~Entry].End = BodyOrder.Num();
+				continue;
+			}
+
+			BoneRanges[Entry].Begin = BodyOrder.Num();
+			if (InBoneToBody[Entry] != INDEX_NONE)
+			{
+				BoneHasBody[Entry] = true;
+				BodyOrder.Add(InBoneToBody[Entry]);
+			}
+			Stack.Push(~Entry);
+			for (int32 ChildIt = FirstChild[Entry + 1] - 1; ChildIt >= FirstChild[Entry]; --ChildIt)
+			{
+				Stack.Push(Children[ChildIt]);
+			}
+		}
+	}
+};
+
+/**
+* Process-wide cache of FPhysicsAssetSubtreeRanges keyed by (physics asset, skeletal mesh), since bone indices are mesh specific.
+* Entries are built on first request and dropped when either asset is modified or garbage collected.
+**/
+class FPhysicsAssetSubtreeRangesCache
+{
+public:
+	static ENGINE_API TSharedPtr<const FPhysicsAssetSubtreeRanges> Get(const UPhysicsAsset* InPhysicsAsset, const USkeletalMesh* InSkeletalMesh);
+
+	//Drop every entry built from InAsset (either a physics asset or a skeletal mesh)
+	static ENGINE_API void Invalidate(const UObject* InAsset);
+
+private:
+	using FKey = TPair<TObjectKey<UPhysicsAsset>, TObjectKey<USkeletalMesh>>;
+
+	static ENGINE_API FRWLock Lock;
+	static ENGINE_API TMap<FKey, TSharedPtr<const FPhysicsAssetSubtreeRanges>> Entries;
+};
@@ -0,0 +1,135 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/EngineBaseTypes.h"
+
+class UWorld;
+class USkeletalMeshComponent;
+class FRootMotionBatch;
+struct FRootMotionMovementParams;
+
+/**
+* Runs FRootMotionBatch::ConvertToWorld on the game thread in TG_PrePhysics. Every batched component's
+* PrimaryComponentTick is a prerequisite (added in AddComponent), and a component tick does not complete before its
+* parallel evaluation task, so all slots of the frame are written when it runs. Nothing depends on it: ACharacter
+* already makes the mesh tick after CharacterMovement, so a movement prerequisite here would close a cycle.
+**/
+struct FRootMotionBatchTickFunction : public FTickFunction
+{
+	FRootMotionBatch* Batch = nullptr;
+
+	//~ Begin FTickFunction Interface
+	ENGINE_API virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	ENGINE_API virtual FString DiagnosticMessage() override;
+	//~ End FTickFunction Interface
+};
+
+/**
+* World-level structure-of-arrays buffer of root motion for all components using batched root motion.
+*
+* Each registered component owns a slot. During its parallel animation evaluation task the component consumes the
+* root motion of its anim instances and writes it, still in local space, into its own slot together with its
+* component and actor transforms (no lock, slots are disjoint). Once all evaluation tasks of the frame have completed,
+* ConvertToWorld (from ConvertTickFunction) converts every slot to a world space delta in one pass, and movement
+* components read their result with USkeletalMeshComponent::ConsumeBatchedRootMotion instead of calling
+* ConsumeRootMotion on the game thread.
+*
+* Batched root motion is consumed one frame late: a movement component ticking before the mesh reads what
+* ConvertToWorld produced last frame. Characters whose CharacterMovementComponent needs root motion in the same frame
+* (it extracts it synchronously in TickCharacterPose, before the evaluation task) are not batched, see
+* USkeletalMeshComponent::CanUseBatchedRootMotion.
+*
+* The arrays are never resized while an evaluation task may be writing: AddComponent only reserves a slot index, and
+* BeginFrame grows the arrays to cover the reserved slots at the start of the world tick, before any tick group runs.
+* Until then IsSlotAllocated is false and the component consumes its root motion the non batched way.
+**/
+class FRootMotionBatch
+{
+public:
+	//Get (and create on first use) the batch for a world. Owned by USkeletalMeshWorldSubsystem
+	static ENGINE_API FRootMotionBatch* Get(UWorld* InWorld);
+
+	/**
+	* Reserve a slot for a component and add its tick as a prerequisite of ConvertTickFunction. Game thread only.
+	* The slot is reused from FreeSlots when possible; a new slot is only backed by the arrays after the next BeginFrame
+	**/
+	ENGINE_API int32 AddComponent(USkeletalMeshComponent* InComponent);
+
+	//Free a slot. Game thread only, the component must not be evaluating
+	ENGINE_API void RemoveComponent(int32 InSlot);
+
+	//Grow the arrays to cover every reserved slot. Game thread, from FWorldDelegates::OnWorldTickStart, no evaluation in flight
+	ENGINE_API void BeginFrame();
+
+	//Whether a slot is backed by the arrays and may be written this frame
+	bool IsSlotAllocated(int32 InSlot) const { return InSlot >= 0 && InSlot < NumAllocated; }
+
+	/**
+	* Store local root motion for a slot. Safe from any thread as long as each slot is only written by its component.
+	* @param InLocalDelta: Root motion in component local space, as returned by ConsumeRootMotion_Internal
+	* @param InBlendAlpha: Root motion blend alpha (FRootMotionMovementParams::BlendWeight)
+	* @param InComponentToWorld: Component transform at the time of evaluation
+	* @param InActorToWorld: Owner transform at the time of evaluation
+	**/
+	void Write(int32 InSlot, const FTransform& InLocalDelta, float InBlendAlpha, const FTransform& InComponentToWorld, const FTransform& InActorToWorld)
+	{
+		checkSlow(IsSlotAllocated(InSlot));
+		const FQuat LocalRotation = InLocalDelta.GetRotation();
+		const FVector LocalTranslation = InLocalDelta.GetTranslation();
+		const FQuat ComponentRotation = InComponentToWorld.GetRotation();
+		const FVector ComponentTranslation = InComponentToWorld.GetTranslation();
+		const FVector ComponentScale = InComponentToWorld.GetScale3D();
+		const FVector ActorOffset = InActorToWorld.GetTranslation() - ComponentTranslation;
+
+		LocalRotX[InSlot] = LocalRotation.X; LocalRotY[InSlot] = LocalRotation.Y; LocalRotZ[InSlot] = LocalRotation.Z; LocalRotW[InSlot] = LocalRotation.W;
+		LocalPosX[InSlot] = LocalTranslation.X; LocalPosY[InSlot] = LocalTranslation.Y; LocalPosZ[InSlot] = LocalTranslation.Z;
+		CompRotX[InSlot] = ComponentRotation.X; CompRotY[InSlot] = ComponentRotation.Y; CompRotZ[InSlot] = ComponentRotation.Z; CompRotW[InSlot] = ComponentRotation.W;
+		CompScaleX[InSlot] = ComponentScale.X; CompScaleY[InSlot] = ComponentScale.Y; CompScaleZ[InSlot] = ComponentScale.Z;
+		ActorOffsetX[InSlot] = ActorOffset.X; ActorOffsetY[InSlot] = ActorOffset.Y; ActorOffsetZ[InSlot] = ActorOffset.Z;
+		BlendAlpha[InSlot] = InBlendAlpha;
+		bHasRootMotion[InSlot] = true;
+	}
+
+	/**
+	* Convert all slots written this frame to world space deltas, matching USkeletalMeshComponent::ConvertLocalRootMotionToWorld.
+	* Called by ConvertTickFunction once per frame, after all parallel evaluation tasks of batched components have completed.
+	**/
+	ENGINE_API void ConvertToWorld();
+
+	/**
+	* Read and clear the world space root motion of a slot.
+	* @return false if the component produced no root motion this frame
+	**/
+	ENGINE_API bool Consume(int32 InSlot, FRootMotionMovementParams& OutParams);
+
+	int32 Num() const { return NumSlots; }
+
+	FRootMotionBatchTickFunction ConvertTickFunction;
+
+private:
+	//Local root motion
+	TArray<double> LocalRotX, LocalRotY, LocalRotZ, LocalRotW;
+	TArray<double> LocalPosX, LocalPosY, LocalPosZ;
+
+	//Component transform and owner offset at the time of evaluation
+	TArray<double> CompRotX, CompRotY, CompRotZ, CompRotW;
+	TArray<double> CompScaleX, CompScaleY, CompScaleZ;
+	TArray<double> ActorOffsetX, ActorOffsetY, ActorOffsetZ;
+
+	//World space result of ConvertToWorld
+	TArray<double> WorldRotX, WorldRotY, WorldRotZ, WorldRotW;
+	TArray<double> WorldPosX, WorldPosY, WorldPosZ;
+
+	TArray<float> BlendAlpha;
+	TArray<bool> bHasRootMotion;
+
+	//Free slots, reused before growing the arrays
+	TArray<int32> FreeSlots;
+
+	//Reserved slots, and slots backed by the arrays (only changes in BeginFrame)
+	int32 NumSlots = 0;
+	int32 NumAllocated = 0;
+};
@@ -0,0 +1,151 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+/**
+* Four rays in structure-of-arrays form for packet culling against skeletal bodies.
+* Unused lanes have a zero length (TMax of -1) and never report a candidate.
+*
+* The cull runs in float, relative to a local origin (the component location) so precision does not degrade far from
+* the world origin: rays and boxes are made relative in double before conversion. Boxes are inflated by
+* GetCullEpsilon of their own magnitude (ToCullBox) and, in IntersectBox, by RayEpsilon, which covers the rounding of
+* the packet's ray starts and of the reciprocal directions (it grows with the start distance and the ray length, so
+* long line of sight traces are covered too). The cull may only keep extra candidates, never drop a body the double
+* precision narrow phase would hit.
+*
+* The cull is a linear pass over the bodies' bounds, and the exact capsule / sphere / box tests are left to the
+* existing single-body narrow phase: a skeletal component has a few dozen bodies, which a SIMD pass over their boxes
+* covers faster than a BVH walk, and only the existing narrow phase gives bit-identical hits.
+**/
+struct FRayPacket4
+{
+	static constexpr int32 Lanes = 4;
+
+	alignas(16) float OriginX[Lanes], OriginY[Lanes], OriginZ[Lanes];
+	alignas(16) float InvDirX[Lanes], InvDirY[Lanes], InvDirZ[Lanes];
+	alignas(16) float TMax[Lanes];
+
+	//Index of each lane's ray in the caller's array
+	int32 RayIndex[Lanes];
+
+	int32 NumActive = 0;
+
+	//Extra box inflation for the rounding of the loaded rays, see GetCullEpsilon
+	float RayEpsilon = 0.f;
+
+	/**
+	* Load up to four rays from InStarts/InEnds starting at InFirst.
+	* Ray parameters are normalized to [0, 1] along Start->End, matching the single query hit Time
+	* @param InLocalOrigin: Origin of the cull space; boxes must be converted with ToCullBox and the same origin
+	**/
+	void Load(TArrayView<const FVector> InStarts, TArrayView<const FVector> InEnds, int32 InFirst, const FVector& InLocalOrigin)
+	{
+		NumActive = FMath::Min(Lanes, InStarts.Num() - InFirst);
+		double MaxMagnitude = 0.0;
+		for (int32 Lane = 0; Lane < Lanes; ++Lane)
+		{
+			if (Lane < NumActive)
+			{
+				const FVector RelativeStart = InStarts[InFirst + Lane] - InLocalOrigin;
+				const FVector RelativeDelta = InEnds[InFirst + Lane] - InStarts[InFirst + Lane];
+				MaxMagnitude = FMath::Max(MaxMagnitude, RelativeStart.GetAbsMax() + RelativeDelta.GetAbsMax());
+
+				const FVector3f Start(RelativeStart);
+				const FVector3f Delta(RelativeDelta);
+				OriginX[Lane] = Start.X; OriginY[Lane] = Start.Y; OriginZ[Lane] = Start.Z;
+				InvDirX[Lane] = SafeReciprocal(Delta.X);
+				InvDirY[Lane] = SafeReciprocal(Delta.Y);
+				InvDirZ[Lane] = SafeReciprocal(Delta.Z);
+				TMax[Lane] = 1.f;
+				RayIndex[Lane] = InFirst + Lane;
+			}
+			else
+			{
+				OriginX[Lane] = OriginY[Lane] = OriginZ[Lane] = 0.f;
+				InvDirX[Lane] = InvDirY[Lane] = InvDirZ[Lane] = UE_BIG_NUMBER;
+				TMax[Lane] = -1.f;
+				RayIndex[Lane] = INDEX_NONE;
+			}
+		}
+		RayEpsilon = GetCullEpsilon(MaxMagnitude);
+	}
+
+	/**
+	* 1 / InValue, or a signed large finite value for zero and denormal components: 1 / denormal is infinite, and
+	* infinity times a zero slab distance would be NaN in IntersectBox, silently dropping the lane
+	**/
+	static float SafeReciprocal(float InValue)
+	{
+		return FMath::Abs(InValue) > UE_SMALL_NUMBER ? 1.f / InValue : (InValue < 0.f ? -UE_BIG_NUMBER : UE_BIG_NUMBER);
+	}
+
+	/**
+	* Absolute inflation covering float rounding for coordinates up to InMagnitude from the local origin: the double to
+	* float conversion (half an ulp) and the subtract/multiply of the slab test (a few ulps). Applied once for the box
+	* magnitude and once for the rays' start distance plus length
+	**/
+	static float GetCullEpsilon(double InMagnitude)
+	{
+		return float(InMagnitude) * 8.f * FLT_EPSILON + UE_KINDA_SMALL_NUMBER;
+	}
+
+	//World space box to the inflated cull space box used by IntersectBox
+	static FBox3f ToCullBox(const FBox& InWorldBox, const FVector& InLocalOrigin)
+	{
+		const FBox Relative = InWorldBox.ShiftBy(-InLocalOrigin);
+		const double Magnitude = FMath::Max(Relative.Min.GetAbsMax(), Relative.Max.GetAbsMax());
+		return FBox3f(Relative).ExpandBy(GetCullEpsilon(Magnitude));
+	}
+
+	/**
+	* Slab test of all four rays against one cull space box (see ToCullBox).
+	* @return Bit mask of the lanes whose segment touches the box (bit N set for lane N)
+	**/
+	int32 IntersectBox(const FBox3f& InCullBox) const
+	{
+		const FBox3f InBox = InCullBox.ExpandBy(RayEpsilon);
+		const VectorRegister4Float OX = VectorLoadAligned(OriginX), OY = VectorLoadAligned(OriginY), OZ = VectorLoadAligned(OriginZ);
+		const VectorRegister4Float IX = VectorLoadAligned(InvDirX), IY = VectorLoadAligned(InvDirY), IZ = VectorLoadAligned(InvDirZ);
+
+		const VectorRegister4Float TX0 = VectorMultiply(VectorSubtract(VectorSetFloat1(InBox.Min.X), OX), IX);
+		const VectorRegister4Float TX1 = VectorMultiply(VectorSubtract(VectorSetFloat1(InBox.Max.X), OX), IX);
+		const VectorRegister4Float TY0 = VectorMultiply(VectorSubtract(VectorSetFloat1(InBox.Min.Y), OY), IY);
+		const VectorRegister4Float TY1 = VectorMultiply(VectorSubtract(VectorSetFloat1(InBox.Max.Y), OY), IY);
+		const VectorRegister4Float TZ0 = VectorMultiply(VectorSubtract(VectorSetFloat1(InBox.Min.Z), OZ), IZ);
+		const VectorRegister4Float TZ1 = VectorMultiply(VectorSubtract(VectorSetFloat1(InBox.Max.Z), OZ), IZ);
+
+		VectorRegister4Float TEnter = VectorMax(VectorMax(VectorMin(TX0, TX1), VectorMin(TY0, TY1)), VectorMin(TZ0, TZ1));
+		VectorRegister4Float TExit = VectorMin(VectorMin(VectorMax(TX0, TX1), VectorMax(TY0, TY1)), VectorMax(TZ0, TZ1));
+		TEnter = VectorMax(TEnter, VectorZeroFloat());
+		TExit = VectorMin(TExit, VectorLoadAligned(TMax));
+
+		return VectorMaskBits(VectorCompareLE(TEnter, TExit));
+	}
+};
+
+/**
+* Candidate list produced by the packet cull: for each ray, the bodies whose world bounds it touches.
+* The narrow phase then runs the existing single-body query on exactly these pairs, so hits are bit-identical to
+* LineTraceComponent / SweepComponent; the packet only removes the bodies a ray cannot reach.
+**/
+struct FSkeletalPacketCandidates
+{
+	//Flattened (ray, body) pairs, grouped by packet
+	TArray<int32> RayIndices;
+	TArray<int32> BodyIndices;
+
+	void Reset()
+	{
+		RayIndices.Reset();
+		BodyIndices.Reset();
+	}
+
+	void Add(int32 InRay, int32 InBody)
+	{
+		RayIndices.Add(InRay);
+		BodyIndices.Add(InBody);
+	}
+};
@@ -0,0 +1,164 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Physics/PhysicsInterfaceCore.h"
+
+class FPhysScene;
+class UWorld;
+class USkeletalMeshComponent;
+
+/**
+* Broadphase statistics for the shared ragdoll aggregates of a world. The broadphase numbers are measured from the
+* physics scene after its last step, not derived from body counts, so comparing captures of the same crowd with and
+* without bUseSharedRagdollAggregate shows the actual win (or its absence).
+**/
+struct FSkeletalMeshAggregateStats
+{
+	//Number of components currently registered with the manager
+	int32 NumComponents = 0;
+
+	//Number of bodies owned by the registered components
+	int32 NumBodies = 0;
+
+	//Number of occupied spatial cells
+	int32 NumCells = 0;
+
+	//Number of live shared aggregates (a crowded cell may need more than one)
+	int32 NumAggregates = 0;
+
+	//Number of components that changed aggregate during the last rebalance
+	int32 NumMovedLastRebalance = 0;
+
+	//Proxies in the scene's broadphase (spatial acceleration structure), all owners
+	int32 BroadphaseProxies = 0;
+
+	//Overlapping pairs the broadphase produced during the last step, all owners
+	int64 BroadphasePairs = 0;
+
+	//Of BroadphasePairs, those where both particles belong to registered components
+	int64 RegisteredBroadphasePairs = 0;
+
+	/**
+	* Whether the physics backend groups an aggregate's bodies in the broadphase. Chaos does not (aggregate handles
+	* are placeholders there), in which case sharing cannot reduce pairs and the manager only collects statistics
+	**/
+	bool bAggregatesEffective = false;
+};
+
+/**
+* Groups the bodies of many nearby USkeletalMeshComponents into shared physics aggregates keyed by spatial cell.
+* Components whose physics asset is below RagdollAggregateThreshold would otherwise each add their bodies to the
+* broadphase individually, which floods it when a crowd of lightly simulated NPCs is in view.
+*
+* One manager exists per world, owned by the world's USkeletalMeshWorldSubsystem and destroyed with it at world
+* cleanup. Components opt in with bUseSharedRagdollAggregate, register when their physics state
+* is created and report their location on transform update. Membership is rebalanced incrementally: a component is
+* only queued for a move once it leaves its cell by more than CellHysteresis, and at most MaxMovesPerRebalance
+* components are moved per call to Rebalance.
+**/
+class FSkeletalMeshAggregateManager
+{
+public:
+	ENGINE_API FSkeletalMeshAggregateManager(FPhysScene* InPhysScene, float InCellSize = 2000.f, float InCellHysteresis = 200.f, int32 InMaxBodiesPerAggregate = 128);
+	ENGINE_API ~FSkeletalMeshAggregateManager();
+
+	FSkeletalMeshAggregateManager(const FSkeletalMeshAggregateManager&) = delete;
+	FSkeletalMeshAggregateManager& operator=(const FSkeletalMeshAggregateManager&) = delete;
+
+	//Get (and create on first use) the manager for the physics scene of the supplied world. See USkeletalMeshWorldSubsystem
+	static ENGINE_API FSkeletalMeshAggregateManager* Get(UWorld* InWorld);
+
+	/**
+	* Register a component and return the aggregate its bodies should be created in.
+	* @param InComponent: The component whose bodies will be instantiated
+	* @param InNumBodies: Number of bodies the component will create
+	* @param InLocation: World location used to pick the spatial cell
+	* @return The shared aggregate to pass to InstantiatePhysicsAsset, or an invalid handle if no room was found or
+	* aggregates have no broadphase effect on this backend (the component is still registered for statistics)
+	**/
+	ENGINE_API FPhysicsAggregateHandle AddComponent(USkeletalMeshComponent* InComponent, int32 InNumBodies, const FVector& InLocation);
+
+	//Unregister a component. Its bodies must already have been removed from the aggregate (TermArticulated)
+	ENGINE_API void RemoveComponent(USkeletalMeshComponent* InComponent);
+
+	//Report a new location for a registered component. Only queues a move, bodies are not touched here
+	ENGINE_API void UpdateComponentLocation(USkeletalMeshComponent* InComponent, const FVector& InLocation);
+
+	/**
+	* Move queued components into the aggregate of their new cell.
+	* Called once per frame from the physics scene pre-tick so moves never happen mid-simulation.
+	* @return Number of components moved
+	**/
+	ENGINE_API int32 Rebalance();
+
+	/**
+	* Recompute statistics for all registered components, reading proxy and pair counts from the scene's solver.
+	* Game thread, outside of the physics step
+	**/
+	ENGINE_API const FSkeletalMeshAggregateStats& UpdateStats();
+
+	const FSkeletalMeshAggregateStats& GetStats() const { return Stats; }
+
+	float GetCellSize() const { return CellSize; }
+	int32 GetMaxBodiesPerAggregate() const { return MaxBodiesPerAggregate; }
+
+	//Maximum number of components moved between aggregates per Rebalance call
+	int32 MaxMovesPerRebalance = 8;
+
+	//Spatial cell containing the location
+	static FIntVector GetCellForLocation(const FVector& InLocation, float InCellSize)
+	{
+		return FIntVector(
+			FMath::FloorToInt32(InLocation.X / InCellSize),
+			FMath::FloorToInt32(InLocation.Y / InCellSize),
+			FMath::FloorToInt32(InLocation.Z / InCellSize));
+	}
+
+	//Whether a location has left InCell by more than InHysteresis on any axis
+	static bool HasLeftCell(const FVector& InLocation, const FIntVector& InCell, float InCellSize, float InHysteresis)
+	{
+		const FVector CellMin = FVector(InCell) * InCellSize - FVector(InHysteresis);
+		const FVector CellMax = FVector(InCell + FIntVector(1)) * InCellSize + FVector(InHysteresis);
+		return InLocation.X < CellMin.X || InLocation.Y < CellMin.Y || InLocation.Z < CellMin.Z
+			|| InLocation.X > CellMax.X || InLocation.Y > CellMax.Y || InLocation.Z > CellMax.Z;
+	}
+
+private:
+	struct FSharedAggregate
+	{
+		FPhysicsAggregateHandle Aggregate;
+		FIntVector Cell;
+		int32 NumBodies = 0;
+		TArray<TObjectKey<USkeletalMeshComponent>> Members;
+	};
+
+	struct FMemberInfo
+	{
+		FIntVector Cell;
+		FVector LastLocation;
+		int32 AggregateIndex = INDEX_NONE;
+		int32 NumBodies = 0;
+		bool bPendingMove = false;
+	};
+
+	//Find an aggregate in InCell with room for InNumBodies, creating one if needed
+	int32 FindOrCreateAggregate(const FIntVector& InCell, int32 InNumBodies);
+
+	//Remove a member from its aggregate, releasing the aggregate once empty
+	void DetachFromAggregate(const TObjectKey<USkeletalMeshComponent>& InKey, FMemberInfo& InOutInfo);
+
+	FPhysScene* PhysScene;
+	float CellSize;
+	float CellHysteresis;
+	int32 MaxBodiesPerAggregate;
+
+	TSparseArray<FSharedAggregate> Aggregates;
+	TMap<FIntVector, TArray<int32, TInlineAllocator<1>>> CellToAggregates;
+	TMap<TObjectKey<USkeletalMeshComponent>, FMemberInfo> Members;
+	TArray<TObjectKey<USkeletalMeshComponent>> PendingMoves;
+
+	FSkeletalMeshAggregateStats Stats;
+};
@@ -0,0 +1,92 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "BoneContainer.h"
+#include "Animation/AnimCurveFilter.h"
+#include "UObject/StrongObjectPtr.h"
+
+class USkeletalMesh;
+class UPhysicsAsset;
+struct FBodyInstance;
+struct FConstraintInstance;
+
+/** State of an asynchronous skeletal mesh swap started with USkeletalMeshComponent::SetSkeletalMeshAsync */
+enum class ESkeletalMeshSwapState : uint8
+{
+	//No swap requested
+	None,
+	//Worker is preparing the new mesh's data
+	Preparing,
+	//Data is ready, waiting for the next frame boundary to commit
+	ReadyToCommit,
+	//Swap was committed
+	Committed,
+	//Swap was cancelled or superseded by another SetSkeletalMesh call
+	Cancelled
+};
+
+/**
+* Everything SetSkeletalMesh rebuilds synchronously, prepared on a worker for an asynchronous swap.
+* The payload only reads the new mesh and its skeleton/physics asset; the component is untouched until commit.
+* It owns everything it prepared: destroying an uncommitted payload (cancel, superseding swap, component destroyed)
+* frees the prepared bodies and constraints, and commit moves them out.
+**/
+struct FSkeletalMeshSwapPayload
+{
+	ENGINE_API FSkeletalMeshSwapPayload();
+
+	//Out of line: FBodyInstance and FConstraintInstance are incomplete here
+	ENGINE_API ~FSkeletalMeshSwapPayload();
+
+	FSkeletalMeshSwapPayload(const FSkeletalMeshSwapPayload&) = delete;
+	FSkeletalMeshSwapPayload& operator=(const FSkeletalMeshSwapPayload&) = delete;
+
+	//Strong so garbage collection cannot destroy the mesh while the swap is pending; the payload is not a UPROPERTY
+	TStrongObjectPtr<USkeletalMesh> NewMesh;
+	bool bReinitPose = true;
+
+	//LOD the payload was prepared for (the component's predicted LOD when the swap started)
+	int32 LODIndex = 0;
+
+	//Shared bone container for the new mesh, becomes SharedRequiredBones on commit
+	TSharedPtr<FBoneContainer> BoneContainer;
+
+	//Required bone lists for LODIndex, become RequiredBones/FillComponentSpaceTransformsRequiredBones on commit
+	TArray<FBoneIndexType> RequiredBones;
+	TArray<FBoneIndexType> FillComponentSpaceTransformsRequiredBones;
+
+	//Curve filtering for the new mesh's curve metadata
+	UE::Anim::FCurveFilterSettings CurveFilterSettings;
+
+	//Reference pose of the new mesh in local and component space, used when bReinitPose is set
+	TArray<FTransform> RefPoseBoneSpaceTransforms;
+	TArray<FTransform> RefPoseComponentSpaceTransforms;
+
+	//Bodies and constraints instantiated in the reference pose but not yet added to the physics scene
+	TArray<TUniquePtr<FBodyInstance>> PreparedBodies;
+	TArray<TUniquePtr<FConstraintInstance>> PreparedConstraints;
+};
+
+/** Handle returned by SetSkeletalMeshAsync */
+struct FSkeletalMeshSwapHandle
+{
+	uint32 SwapId = 0;
+
+	bool IsValid() const { return SwapId != 0; }
+};
+
+/** Timing of the last committed swap, for measuring the game thread cost */
+struct FSkeletalMeshSwapStats
+{
+	//Worker time spent preparing the payload
+	double PrepareTimeMs = 0.0;
+
+	//Game thread time spent in the commit
+	double CommitTimeMs = 0.0;
+
+	//Frames between the request and the commit
+	int32 FramesToCommit = 0;
+};
@@ -0,0 +1,89 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+
+class UWorld;
+class USkeletalMeshComponent;
+
+/** Per-component ticks that can be batched into one tick function per world */
+enum class ESkeletalMeshBatchedTick : uint8
+{
+	//FSkeletalMeshComponentEndPhysicsTickFunction, TG_EndPhysics
+	EndPhysics,
+	//FSkeletalMeshComponentClothTickFunction, TG_PreCloth
+	Cloth,
+	Num
+};
+
+/**
+* One tick function standing in for the per-component EndPhysics or cloth ticks of every participating component
+* in a world. ExecuteTick walks the compact component array in chunks of ChunkSize: the thread safe preparation
+* (ShouldRunEndPhysicsTick / cloth context gathering) runs on workers, one task per chunk, then the game thread
+* applies the results in array order, which is the work the per-component tick would have done.
+*
+* The batch tick stands in for the per-component tick in the tick graph too:
+*  - every member's PrimaryComponentTick is a prerequisite (added by Add, removed by Remove), as it is of the
+*    per-component EndPhysics and cloth ticks
+*  - the EndPhysics batch passes itself to EndPhysicsTickComponent_Batched, so each component's parallel blend
+*    completion task is chained onto the batch's completion handle, and the cloth batch passes itself to TickClothing
+*  - the cloth batch has the EndPhysics batch as a prerequisite, so cloth never starts before a member's blend is done
+**/
+struct FSkeletalMeshBatchedTickFunction : public FTickFunction
+{
+	ESkeletalMeshBatchedTick Kind = ESkeletalMeshBatchedTick::EndPhysics;
+
+	//Participating components; a component's position is stored in its BatchedTickIndices[Kind]
+	TArray<USkeletalMeshComponent*> Components;
+
+	//Components per worker task
+	int32 ChunkSize = 32;
+
+	//~ Begin FTickFunction Interface
+	ENGINE_API virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	ENGINE_API virtual FString DiagnosticMessage() override;
+	ENGINE_API virtual FName DiagnosticContext(bool bDetailed) override;
+	//~ End FTickFunction Interface
+};
+
+/**
+* Owns the batched tick functions of a world. Components opt in with bUseBatchedPhysicsTicks; their
+* UpdateEndPhysicsTickRegisteredState / UpdateClothTickRegisteredState then add or remove them here instead of
+* registering their own tick function. Add and Remove are O(1): Remove swaps the last component into the hole and
+* patches its index, so toggling every frame costs nothing beyond the array write.
+*
+* A component whose own tick has prerequisites (AddTickPrerequisiteComponent / Actor on the EndPhysics or cloth tick)
+* is not batched: a shared tick cannot honour per-component dependencies.
+**/
+class FSkeletalMeshBatchedTickManager
+{
+public:
+	//Get (and create and register on first use) the manager for a world. Owned by USkeletalMeshWorldSubsystem
+	static ENGINE_API FSkeletalMeshBatchedTickManager* Get(UWorld* InWorld);
+
+	//Unregisters the batched tick functions
+	ENGINE_API ~FSkeletalMeshBatchedTickManager();
+
+	//Add a component to a batch and its PrimaryComponentTick to the batch's prerequisites. No-op if it is already in it
+	ENGINE_API void Add(USkeletalMeshComponent* InComponent, ESkeletalMeshBatchedTick InKind);
+
+	//Remove a component from a batch and its PrimaryComponentTick from the batch's prerequisites. No-op if it is not in it
+	ENGINE_API void Remove(USkeletalMeshComponent* InComponent, ESkeletalMeshBatchedTick InKind);
+
+	int32 Num(ESkeletalMeshBatchedTick InKind) const { return TickFunctions[static_cast<int32>(InKind)].Components.Num(); }
+
+	ENGINE_API explicit FSkeletalMeshBatchedTickManager(UWorld* InWorld);
+
+	FSkeletalMeshBatchedTickManager(const FSkeletalMeshBatchedTickManager&) = delete;
+	FSkeletalMeshBatchedTickManager& operator=(const FSkeletalMeshBatchedTickManager&) = delete;
+
+private:
+
+	//The batch tick is only registered while it has components, so an empty batch costs the task graph nothing
+	void UpdateRegistration(ESkeletalMeshBatchedTick InKind);
+
+	UWorld* World = nullptr;
+	FSkeletalMeshBatchedTickFunction TickFunctions[static_cast<int32>(ESkeletalMeshBatchedTick::Num)];
+};
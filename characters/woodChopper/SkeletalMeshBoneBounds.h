@@ -0,0 +1,94 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+class UPhysicsAsset;
+class USkeletalMesh;
+
+/**
+* Local space bounding box of every physics body, keyed by the mesh bone it is attached to.
+* Built once per (physics asset, skeletal mesh) from the aggregate geometry of each body setup and shared by all
+* components using that pair, so CalcBounds only has to transform boxes instead of walking collision shapes.
+**/
+struct FSkeletalMeshBoneBounds
+{
+	//Mesh bone index per box
+	TArray<FBoneIndexType> BoneIndices;
+
+	//Box centers and half extents in bone space, stored as four floats for aligned vector loads
+	TArray<FVector4f> Centers;
+	TArray<FVector4f> Extents;
+
+	int32 Num() const { return BoneIndices.Num(); }
+
+	void Add(FBoneIndexType InBoneIndex, const FBox3f& InLocalBox)
+	{
+		BoneIndices.Add(InBoneIndex);
+		Centers.Add(FVector4f(InLocalBox.GetCenter(), 0.f));
+		Extents.Add(FVector4f(InLocalBox.GetExtent(), 0.f));
+	}
+
+	//Get (building on first request) the shared bone bounds for a physics asset on a mesh
+	static ENGINE_API TSharedPtr<const FSkeletalMeshBoneBounds> Get(const UPhysicsAsset* InPhysicsAsset, const USkeletalMesh* InSkeletalMesh);
+
+	//Drop cached entries built from InAsset (either a physics asset or a skeletal mesh)
+	static ENGINE_API void Invalidate(const UObject* InAsset);
+};
+
+namespace BoneBounds
+{
+	/**
+	* Component space AABB enclosing every bone box transformed by its bone's component space transform.
+	* Each box is transformed as center' = M * center and extent' = |M| * extent, then merged with vector min/max.
+	* @return The merged box, invalid if no bone box had a valid transform
+	**/
+	inline FBox CalcTransformedBounds(const FSkeletalMeshBoneBounds& InBoneBounds, TArrayView<const FTransform> InComponentSpaceTransforms)
+	{
+		VectorRegister4Float Min = VectorSetFloat1(UE_BIG_NUMBER);
+		VectorRegister4Float Max = VectorSetFloat1(-UE_BIG_NUMBER);
+		bool bAny = false;
+
+		for (int32 Index = 0; Index < InBoneBounds.Num(); ++Index)
+		{
+			const int32 BoneIndex = InBoneBounds.BoneIndices[Index];
+			if (!InComponentSpaceTransforms.IsValidIndex(BoneIndex))
+			{
+				continue;
+			}
+
+			const FMatrix44f Matrix(InComponentSpaceTransforms[BoneIndex].ToMatrixWithScale());
+			const VectorRegister4Float Row0 = VectorLoadAligned(&Matrix.M[0][0]);
+			const VectorRegister4Float Row1 = VectorLoadAligned(&Matrix.M[1][0]);
+			const VectorRegister4Float Row2 = VectorLoadAligned(&Matrix.M[2][0]);
+			const VectorRegister4Float Row3 = VectorLoadAligned(&Matrix.M[3][0]);
+
+			const VectorRegister4Float Center = VectorLoadAligned(&InBoneBounds.Centers[Index]);
+			const VectorRegister4Float Extent = VectorLoadAligned(&InBoneBounds.Extents[Index]);
+
+			VectorRegister4Float NewCenter = VectorMultiplyAdd(VectorReplicate(Center, 0), Row0, Row3);
+			NewCenter = VectorMultiplyAdd(VectorReplicate(Center, 1), Row1, NewCenter);
+			NewCenter = VectorMultiplyAdd(VectorReplicate(Center, 2), Row2, NewCenter);
+
+			VectorRegister4Float NewExtent = VectorMultiply(VectorReplicate(Extent, 0), VectorAbs(Row0));
+			NewExtent = VectorMultiplyAdd(VectorReplicate(Extent, 1), VectorAbs(Row1), NewExtent);
+			NewExtent = VectorMultiplyAdd(VectorReplicate(Extent, 2), VectorAbs(Row2), NewExtent);
+
+			Min = VectorMin(Min, VectorSubtract(NewCenter, NewExtent));
+			Max = VectorMax(Max, VectorAdd(NewCenter, NewExtent));
+			bAny = true;
+		}
+
+		if (!bAny)
+		{
+			return FBox(ForceInit);
+		}
+
+		FVector4f MinStore, MaxStore;
+		VectorStoreAligned(Min, &MinStore);
+		VectorStoreAligned(Max, &MaxStore);
+		return FBox(FVector(MinStore.X, MinStore.Y, MinStore.Z), FVector(MaxStore.X, MaxStore.Y, MaxStore.Z));
+	}
+}
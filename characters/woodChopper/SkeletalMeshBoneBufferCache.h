@@ -0,0 +1,110 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Hash/CityHash.h"
+#include "RHIResources.h"
+#include "UObject/ObjectKey.h"
+
+class USkeletalMesh;
+
+DECLARE_STATS_GROUP(TEXT("Skeletal Mesh Bone Buffers"), STATGROUP_SkelMeshBoneBuffers, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bone Buffers Requested"), STAT_SkelMeshBoneBuffersTotal, STATGROUP_SkelMeshBoneBuffers, ENGINE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bone Buffers Uploaded"), STAT_SkelMeshBoneBuffersUnique, STATGROUP_SkelMeshBoneBuffers, ENGINE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bone Buffer Bytes Saved"), STAT_SkelMeshBoneBufferBytesSaved, STATGROUP_SkelMeshBoneBuffers, ENGINE_API);
+
+/** Identity of a finalized pose: same mesh, same LOD and bit-identical ref-to-local matrices */
+struct FSkeletalMeshBonePoseKey
+{
+	TObjectKey<USkeletalMesh> Mesh;
+	int32 LODIndex = INDEX_NONE;
+	uint64 PoseHash = 0;
+
+	bool operator==(const FSkeletalMeshBonePoseKey& Other) const
+	{
+		return PoseHash == Other.PoseHash && LODIndex == Other.LODIndex && Mesh == Other.Mesh;
+	}
+
+	friend uint32 GetTypeHash(const FSkeletalMeshBonePoseKey& Key)
+	{
+		return HashCombine(static_cast<uint32>(Key.PoseHash), GetTypeHash(Key.Mesh));
+	}
+
+	//Hash of the matrices as uploaded. Concurrent thread, once per component per frame
+	static uint64 HashPose(TArrayView<const FMatrix44f> InRefToLocals, int32 InLODIndex)
+	{
+		return CityHash64WithSeed(reinterpret_cast<const char*>(InRefToLocals.GetData()), InRefToLocals.Num() * sizeof(FMatrix44f), static_cast<uint64>(InLODIndex));
+	}
+};
+
+/** A bone buffer shared by every component that submitted the same pose this frame */
+struct FSharedBoneBuffer : public FRefCountBase
+{
+	FBufferRHIRef Buffer;
+	FShaderResourceViewRHIRef SRV;
+
+	//Size of the upload, for the saved bytes stat
+	uint32 NumBytes = 0;
+
+	//Copy of the uploaded matrices, for the collision check. Owned here so it cannot dangle when the first
+	//submitter's dynamic data is replaced mid-frame; the allocation is reused with the buffer
+	TArray<FMatrix44f> Pose;
+};
+
+/** Unique vs total bone buffers of the last frame */
+struct FSkeletalMeshBoneBufferStats
+{
+	int32 NumRequested = 0;
+	int32 NumUnique = 0;
+
+	//Bytes not uploaded thanks to sharing
+	uint64 BytesSaved = 0;
+
+	//Hash matches rejected by the full comparison
+	int32 NumCollisions = 0;
+};
+
+/**
+* Render thread cache of bone buffers keyed by finalized pose, one per scene. Crowds playing the same animation in
+* lockstep (idle villagers, synchronized chop loops) produce bit-identical ref-to-local matrices, since they are
+* component space and independent of where the character stands; those components reference one buffer instead of
+* each uploading its own.
+*
+* Entries live for one frame: BeginFrame drops the previous frame's entries into Retired, and a retired buffer only
+* returns to the free list once the cache holds its last reference (refcount 1, as FSkeletalMeshPoseSnapshotSlot
+* recycles snapshots). Vertex factories keep the previous frame's bone buffer for velocity, so a buffer still
+* referenced there is never overwritten. A hash match is confirmed with a full comparison against the pose copy
+* kept in the buffer before the buffer is shared.
+**/
+class FSkeletalMeshBoneBufferCache
+{
+public:
+	//Get the cache for a scene (created on first use). Render thread
+	static ENGINE_API FSkeletalMeshBoneBufferCache& Get(const class FSceneInterface* InScene);
+
+	//Start a new frame: retire last frame's entries, recycle retired buffers nobody references and publish stats. Render thread
+	ENGINE_API void BeginFrame();
+
+	/**
+	* Get the buffer for a pose, uploading InRefToLocals only if no component submitted the same pose this frame.
+	* @param InKey: Pose identity, with PoseHash from FSkeletalMeshBonePoseKey::HashPose
+	* @param InRefToLocals: The pose; copied into the buffer on upload, so it only needs to live for the call
+	**/
+	ENGINE_API TRefCountPtr<FSharedBoneBuffer> FindOrUpload(FRHICommandListBase& RHICmdList, const FSkeletalMeshBonePoseKey& InKey, TArrayView<const FMatrix44f> InRefToLocals);
+
+	const FSkeletalMeshBoneBufferStats& GetLastFrameStats() const { return LastFrameStats; }
+
+private:
+	TMap<FSkeletalMeshBonePoseKey, TRefCountPtr<FSharedBoneBuffer>> Entries;
+
+	//Buffers of earlier frames that may still be referenced (previous frame bones of vertex factories)
+	TArray<TRefCountPtr<FSharedBoneBuffer>> Retired;
+
+	//Buffers only the cache references, by size in bytes
+	TMap<uint32, TArray<TRefCountPtr<FSharedBoneBuffer>>> FreeBuffers;
+
+	FSkeletalMeshBoneBufferStats FrameStats;
+	FSkeletalMeshBoneBufferStats LastFrameStats;
+};
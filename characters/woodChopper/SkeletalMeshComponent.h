@@ -20,6 +20,27 @@
 #include "ClothingSimulationInterface.h"
 #include "ClothingSimulationFactory.h"
 #include "Animation/AttributesRuntime.h"
+#include "SkeletalMeshPhysicsBlend.h"
+#include "PhysicsAssetSubtreeRanges.h"
+#include "PhysicsAssetNameIndex.h"
+#include "MorphTargetHandles.h"
+#include "RootMotionBatch.h"
+#include "SkeletalMeshOverlapCache.h"
+#include "SkeletalMeshBoneBounds.h"
+#include "AnimNotifyBatchDispatcher.h"
+#include "LinkedInstanceScheduler.h"
+#include "SkeletalNavGeometryCache.h"
+#include "SkeletalBodyPacketQuery.h"
+#include "SkeletalTriangleBVH.h"
+#include "SkeletalMeshAsyncSwap.h"
+#include "BoneContainerInternCache.h"
+#include "SkeletalMeshTaskBreadcrumbs.h"
+#include "SkeletalMeshBatchedTick.h"
+#include "SkeletalMeshPoseSnapshot.h"
+#include "SkeletalMeshIncrementalFK.h"
+#include "SkeletalMeshQuantizedBones.h"
+#include "SkeletalMeshBoneBufferCache.h"
+#include "SkeletalMeshVertexAnimationPlayback.h"
 #if WITH_ENGINE
   #include "Engine/PoseWatchRenderData.h"
   #endif
@@ -35,6 +56,9 @@ class UAnimInstance;
 class UPhysicalMaterial; 
 class USkeletalMesh;
 class USkeletalMeshComponent;
+class FSkelMeshFrameRecorder;
+class USkeletalMeshVertexAnimation;
+class UStaticMeshComponent;
 struct FClothCollionSource;
 struct FConstraintInstance;
 struct FConstraintProfileProperties;
@@ -313,6 +337,10 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
     friend struct FLinkedInstanceAdapater;
     friend struct FLinkedAnimLayerClassData; 
     friend struct FRigUnit_AnimNextWriteSkeletalMeshComponentPose;
+    friend class USkeletalMeshComponentPool;
+    friend class FSkelMeshFrameReplayer;
+    friend class FSkeletalMeshBatchedTickManager;
+    friend struct FSkeletalMeshBatchedTickFunction;
 
     #if WITH_EDITORONLY_DATA
       private: 
@@ -338,6 +366,21 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
       //Gets the shared bone container used between all owned anim instances. Creates it on the first call
       ENGINE_API TSharedPtr<struct FBoneContainer> GetSharedRequiredBones();
 
+      /**
+      *Gets the immutable bone container for the current mesh, skeleton, LOD and curve filter from FBoneContainerInternCache.
+      *Shared with every other component in the same configuration, so it must never be modified. Used by anim instances in place
+      *of GetSharedRequiredBones when the component has no per-instance bone overrides
+      */
+      ENGINE_API TSharedPtr<const struct FBoneContainer> GetInternedRequiredBones();
+
+      /**
+      *Copy-on-write access for the anim instance proxy before it writes its bone container (InitializeTo in
+      *RecalcRequiredBones, SetUseRAWData). If the proxy holds the interned container, replaces it with
+      *FBoneContainerInternCache::MakeWritableCopy and returns the copy; otherwise returns GetSharedRequiredBones.
+      *The component stops using the interned container until its next LOD or mesh change
+      */
+      ENGINE_API TSharedPtr<struct FBoneContainer> GetWritableRequiredBones();
+
       #if WITH_EDITORONLY_DATA
         //The blueprint for creating AnimationScript
         UPROPERTY()
@@ -414,6 +457,20 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
         //Get th bone space transforms as an array view
         ENGINE_API TArrayView<const FTransform> GetBoneSpaceTransformsView();
 
+        /**
+        * Last completed pose as an immutable, refcounted snapshot. Safe from any thread at any time, including during
+        * ParallelAnimationEvaluation, and no copy is made: hold the pointer for as long as needed, the snapshot is
+        * reclaimed once the last reader releases it. Null unless bPublishPoseSnapshots is set and a pose was evaluated
+        **/
+        FSkeletalMeshPoseSnapshotPtr GetPublishedPose() const { return PublishedPose.Read(); }
+
+        //Version of the last published pose, to skip work when it has not changed. Any thread
+        uint64 GetPublishedPoseVersion() const { return PublishedPose.GetVersion(); }
+
+        //If true, each completed evaluation publishes a pose snapshot for GetPublishedPose (one copy of the pose per evaluation)
+        UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadWrite, Category = Animation)
+        uint8 bPublishPoseSnapshots:1;
+
         /*
         *Temporary array of local-space (relative to parent bone) rotation/translation for each bone.
         *This property is not saf to accss during evaluation, so we created wrapper
@@ -441,9 +498,21 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
       UPROPERTY(transient)
       TArray<TObjectPtr<UAnimInstance>> LinkedInstances;
 
+      //Tag to linked instance lookup, rebuilt whenever LinkedInstances changes (see FLinkedInstancesAdapter)
+      TMap<FName, TWeakObjectPtr<UAnimInstance>> LinkedInstancesByTag;
+
+      //Parallel update waves for LinkedInstances, rebuilt with LinkedInstancesByTag
+      FLinkedInstanceSchedule LinkedInstanceSchedule;
+
+      //Rebuild LinkedInstancesByTag and LinkedInstanceSchedule from the linked graph and layer nodes of the main instance
+      void RebuildLinkedInstanceIndex();
+
       //Shared bone container betwee all anim instances owned by this skeletal mesh component
       TSharedPtr<struct FBoneContainer> SharedRequiredBones;
 
+      //Interned bone container for the current configuration, refreshed when the LOD, mesh or curve filter changes
+      TSharedPtr<const struct FBoneContainer> InternedRequiredBones;
+
       //Update Rate
 
       //Cached BoneSpaceTransforms for Update Rate optimization
@@ -613,6 +682,42 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = Physics)
 	uint8 bUpdateOverlapsOnAnimationFinalize:1;
 
+	// When updating overlaps on animation finalize, only requery bodies whose bounds moved more than OverlapRefreshTolerance since their last query. Other bodies reuse cached results 
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = Physics, meta = (EditCondition = bUpdateOverlapsOnAnimationFinalize))
+	uint8 bUseMotionThresholdedOverlaps:1;
+
+	// Distance (in cm) a body's bounds must move before its overlaps are queried again. See bUseMotionThresholdedOverlaps 
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = Physics, meta = (EditCondition = bUseMotionThresholdedOverlaps, ClampMin = 0.f))
+	float OverlapRefreshTolerance = 2.f;
+
+	// Send bone transforms to the render proxy quantized (12 bytes per bone instead of 48) and decode them in the skinning vertex factory. See QuantizedBones for the error bounds 
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = Rendering)
+	uint8 bQuantizeBoneTransforms:1;
+
+	// Use 15 bit instead of 10 bit rotation components (16 bytes per bone) when bQuantizeBoneTransforms is set 
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = Rendering, meta = (EditCondition = bQuantizeBoneTransforms))
+	uint8 bHighPrecisionQuantizedBones:1;
+
+	// Share one bone buffer between components of the same mesh and LOD whose finalized poses are identical this frame (see FSkeletalMeshBoneBufferCache) 
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = Rendering)
+	uint8 bShareIdenticalBoneBuffers:1;
+
+	// Beyond VertexAnimationDistance, stop evaluating and skinning the mesh and play the baked VertexAnimation texture on a proxy static mesh instead 
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Rendering|VertexAnimation")
+	uint8 bUseVertexAnimationLOD:1;
+
+	// Distance (in cm) from the closest view below which skeletal playback comes back; texture playback starts past VertexAnimationDistance + VertexAnimationHysteresis. See bUseVertexAnimationLOD 
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Rendering|VertexAnimation", meta = (EditCondition = bUseVertexAnimationLOD, ClampMin = 0.f))
+	float VertexAnimationDistance = 5000.f;
+
+	// Extra distance (in cm) past VertexAnimationDistance before switching to texture playback, so characters on the boundary do not flicker between modes 
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Rendering|VertexAnimation", meta = (EditCondition = bUseVertexAnimationLOD, ClampMin = 0.f))
+	float VertexAnimationHysteresis = 500.f;
+
+	// Baked texture, proxy mesh and clips for this mesh (see USkeletalMeshVertexAnimationBakeCommandlet) 
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "Rendering|VertexAnimation", meta = (EditCondition = bUseVertexAnimationLOD))
+	TObjectPtr<USkeletalMeshVertexAnimation> VertexAnimation;
+
 	// Temporary fix for local space kinematics. This only works for bodies that have no constraints and is needed by vehicles. Proper support will remove this flag 
 	uint8 bLocalSpaceKinematics:1;
 
@@ -751,6 +856,14 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	*/
 	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadOnly, Category=SkeletalMesh)
 	uint8 bEnablePerPolyCollision:1;
+
+	/**
+	* With per-poly collision, refit the triangle BVH from bone transforms only and skin just the vertices of the leaves a
+	* query visits, instead of skinning the whole LOD on the first query of a frame. See FSkeletalTriangleBVH.
+	* Active morph targets inflate the bounds; while cloth simulates on the LOD the BVH falls back to a full refit.
+	*/
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadOnly, Category=SkeletalMesh, meta=(EditCondition = bEnablePerPolyCollision))
+	uint8 bLazyPerPolySkinning:1;
 	
 	/**
 	 * Misc 
@@ -806,6 +919,14 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = Optimization)
 	unit8 bSkipBoundsUpdateWhenInterpolating:1;
 
+	/**
+	* If greater than 0, bounds only ever grow between tight recomputes, and are recomputed tight every this many frames.
+	* Keeps the bounds conservative while avoiding a primitive bounds update each frame the pose moves inside them.
+	* 0 disables the expand-only mode.
+	**/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, AdvancedDisplay, Category = Optimization, meta = (ClampMin = 0))
+	int32 ExpandOnlyBoundsRefreshInterval = 0;
+
     protected:
 
 	// Whether the clothing simulation is suspended (not the same as disabled, we no longer run the sim but keep the last valid sim data around) 
@@ -839,6 +960,9 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	//Physcics-enigine representation of aggrgate which contains aphysics assest instance with more than numbers of bodies
 	FPhysicsAggregateHandle Aggregate;
 
+	//True if Aggregate is owned by the world's FSkeletalMeshAggregateManager and must not be released by this component
+	uint8 bAggregateIsShared:1;
+
     public:
 
 	//Cache ANimCurveUidVersion from Skeleton and this will be used to identify if it needs to be updated
@@ -883,6 +1007,26 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 
 	ENGINE_API void CreateBodySetup();
 
+	/**
+	* Get the per-poly triangle BVH of a LOD, refit to the current pose. Built in the reference pose on first use and
+	* refit at most once per frame, and only when a query asks for it. Uses RefitConservative (with the summed active
+	* morph target weights) when bLazyPerPolySkinning is set and no cloth simulates on the LOD, Refit otherwise
+	**/
+	ENGINE_API const FSkeletalTriangleBVH* GetPerPolyBVH(int32 LODIndex);
+
+    private:
+	// Per-LOD triangle BVHs for per-poly collision, built lazily 
+	TArray<TUniquePtr<FSkeletalTriangleBVH>> PerPolyBVHs;
+
+	// Frame number each PerPolyBVHs entry was last refit on 
+	TArray<uint32> PerPolyBVHRefitFrames;
+
+	// Vertex positions skinned this frame for lazy per-poly queries, and the frame each was skinned on 
+	TArray<FVector3f> PerPolyLazyPositions;
+	TArray<uint32> PerPolyLazyPositionFrames;
+
+    public:
+
 	#if UE_ENABLED_DEBUG_DRAWING
 		ENGINE_API virtual void SendRender DebugPhysics(FPrimitiveSceneProxy* OverrideSceneProxy = nullptr) override;
 	#endif
@@ -892,6 +1036,25 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	//Threshold for physics asset bodies abov which we use an aggregate foro boardphase collisions
 	int32 RagdollAggregateThreshold;
 
+	/**
+	* If true, physics assets with fewer bodies than RagdollAggregateThreshold put their bodies in an aggregate shared with
+	* other nearby components (one per spatial cell) instead of adding each body to the broadphase on its own.
+	* See FSkeletalMeshAggregateManager. Useful for crowds of lightly simulated characters.
+	* Only reduces broadphase pairs on a backend that groups aggregates. Chaos does not (aggregate handles are
+	* placeholders there): the component is registered for statistics only and its bodies are added as usual, see
+	* FSkeletalMeshAggregateStats::bAggregatesEffective.
+	**/
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadOnly, Category = Physics)
+	uint8 bUseSharedRagdollAggregate:1;
+
+	/**
+	* If true, the EndPhysics and cloth ticks of this component run inside one batched tick function per world
+	* (see FSkeletalMeshBatchedTickManager) instead of registering their own tick functions. Ignored while either
+	* tick function has prerequisites.
+	**/
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadOnly, Category = Physics)
+	uint8 bUseBatchedPhysicsTicks:1;
+
 	UPROPERTY(Interp, BlueprintReadWrite, Category = Clothing, meta = (UIMin = 0.0, UIMax = 10.0, ClampMin = 0.0, ClampMax = 10000.0))
 	float ClothMaxDistanceScalel
 
@@ -1013,6 +1176,24 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	//Intrnal helper -- copis the mesh's reference pose to th local space. Transforms and regenerates component space transforms accordingly
 	void ResetToRefPose();
 
+	/**
+	* Bring a pooled component back to a freshly spawned state without re-running registration or anim init.
+	* Resets to the ref pose, resets anim instance dynamics and montages, clears morph targets and pending forces,
+	* and teleports the bodies, which keep their physics state. Used by USkeletalMeshComponentPool
+	**/
+	ENGINE_API void ResetForPoolReuse();
+
+    public:
+	/**
+	* Report this component's inputs (moves, SetPosition, SetPlayRate, physics blend weight, montage starts) to a recorder.
+	* Set by FSkelMeshFrameRecorder::Start and cleared by Stop; null when not recording
+	**/
+	void SetFrameRecorder(FSkelMeshFrameRecorder* InRecorder) { FrameRecorder = InRecorder; }
+	FSkelMeshFrameRecorder* GetFrameRecorder() const { return FrameRecorder; }
+
+    private:
+	FSkelMeshFrameRecorder* FrameRecorder = nullptr;
+
     public: 
 	UE_DEPRECATED(4.23, "This function is dprecated. Please use GetLinkedAnimGraphInsanceByTag")
 	UAnimInstance* GetSubInstanceByName(FName InTag) const {return GetLinkedAnimGraphInstanceByTag(InTag);}
@@ -1088,6 +1269,24 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	
 	// Calls a function on each of the anim instances that this mesh component hosts, including linked and post-process instances 
 	ENGINE_API void ForEachAnimInstance(TFunctionRef<void(UAnimInstance*)> InFunction);
+
+	/**
+	* Game thread update of linked instances (UpdateAnimation, which runs NativeUpdateAnimation and
+	* BlueprintUpdateAnimation) in LinkedInstanceSchedule order, serially. Called from TickAnimInstances in place of the
+	* LinkedInstances loop
+	**/
+	ENGINE_API void UpdateLinkedInstancesScheduled(float DeltaTime, bool bNeedsValidRootMotion);
+
+	/**
+	* Worker side of the linked instance update: runs the proxies' ParallelUpdateAnimation wave by wave, a wave in
+	* parallel when it has at least ParallelLinkedInstanceThreshold instances. Called from the evaluation task
+	* (PerformAnimationProcessing), never from the game thread
+	**/
+	ENGINE_API void ParallelUpdateLinkedInstanceProxies_AnyThread();
+
+	// Minimum number of linked instances in a wave before their proxy update runs in parallel 
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = Animation, meta = (ClampMin = 2))
+	int32 ParallelLinkedInstanceThreshold = 4;
 	
 	/** 
 	 * Returns whether there are any valid instances to run, currently this means whether we have
@@ -1208,6 +1407,8 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 
 	/**
 	* Set Morph Target with Name and Value(0-1)
+	* Resolves the name on the current mesh and writes MorphTargetWeights, like the handle version; only names the mesh
+	* does not have are kept in MorphTargetCurves until a mesh that has them is set
 	*
 	* @param bRemoveZeroWeight : Used by editor code when it should stay in the active list with zero weight
 	**/
@@ -1221,11 +1422,36 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	ENGINE_API void ClearMorphTargets();
 
 	/** 
-	* Get Morph target w/ the given name
+	* Get Morph target w/ the given name. Reads MorphTargetWeights, so it sees weights set by handle too
 	**/
 	UFUNCTION(BlueprintCallable, Category="Components|SkeletalMesh")
 	ENGINE_API float GetMorphTarget(FName MorphTargetName) const;
 
+	/**
+	* Resolve a morph target name once for use with the handle versions of SetMorphTarget/GetMorphTarget.
+	* Returns an unset handle if the current mesh has no such morph target
+	**/
+	ENGINE_API FMorphTargetHandle FindMorphTargetHandle(FName MorphTargetName) const;
+
+	/**
+	* Set Morph Target by handle. Cheaper than the name version: no lookup and no map insert.
+	* Stale or unset handles are ignored
+	**/
+	ENGINE_API void SetMorphTarget(const FMorphTargetHandle& Handle, float Value, bool bRemoveZeroWeight = true);
+
+	/** Get Morph Target weight by handle, 0 for stale or unset handles */
+	float GetMorphTarget(const FMorphTargetHandle& Handle) const
+	{
+		return Handle.Serial == MorphTargetHandleSerial ? MorphTargetWeights.Get(Handle.Index) : 0.f;
+	}
+
+	/** Get the morph targets that will be applied at the given LOD (weight above MorphTargetWeightThreshold and deltas in that LOD) */
+	ENGINE_API void GetActiveMorphTargetsForLOD(int32 LODIndex, FMorphTargetLODActiveSet& OutActiveSet) const;
+
+	/** Morph target weights with an absolute value at or below this are dropped from the active set and not applied */
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadWrite, Category = SkeletalMesh, meta = (ClampMin = 0.f))
+	float MorphTargetWeightThreshold = UE_KINDA_SMALL_NUMBER;
+
 	/** 
 	* Takes a snapshot of this skeletal mesh component's pose and saves it to the specifiede snapshot
 	* The snapshot is taken at the current LOD, so if for example, you ook th snapshot at LOD1
@@ -1431,12 +1657,43 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	//Temporary array of bon indicies required to populate component space transforms
 	TArray<FBoneIndexType> FillComponentSpaceTransformsRequiredBones;
 
+	//Dirty subtree tracking for FillComponentSpaceTransforms, rebuilt with FillComponentSpaceTransformsRequiredBones when bUseIncrementalFK is set.
+	//FillComponentSpaceTransforms passes the other buffer of the evaluation context pair as the previous output, since buffers swap every evaluation
+	FSkeletalMeshIncrementalFK IncrementalFK;
+
 	//Array of FBodyInstance objects, storing per-instance state about each body part
 	TArray<struct FBodyInstance*> Bodies;
 
 	//Array of FConstriantInstance structs, storing per-instance state about each constraint
 	TArray<struct FConstraintInstance*> Constraints;
 
+	//Depth-first body ordering and per-bone subtree ranges for the current physics asset, set up in InitArticulated
+	TSharedPtr<const FPhysicsAssetSubtreeRanges> BodySubtreeRanges;
+
+	//Hashed body and constraint name lookup for the current physics asset, set up in InitArticulated
+	TSharedPtr<const FPhysicsAssetNameIndex> PhysicsNameIndex;
+
+	//Incremented every time Bodies/Constraints are re-created, used to detect stale FBodyHandle/FConstraintHandle
+	uint32 PhysicsStateSerial = 0;
+
+	//Resolve a body name once. Returns an unset handle if there is no such body
+	ENGINE_API FBodyHandle FindBodyHandle(FName BoneName) const;
+
+	//Get the body for a handle, or nullptr if the handle is unset or stale
+	FBodyInstance* GetBodyInstance(const FBodyHandle& Handle) const
+	{
+		return (Handle.Serial == PhysicsStateSerial && Bodies.IsValidIndex(Handle.Index)) ? Bodies[Handle.Index] : nullptr;
+	}
+
+	//Resolve a constraint joint name once. Returns an unset handle if there is no such constraint
+	ENGINE_API FConstraintHandle FindConstraintHandle(FName ConstraintName) const;
+
+	//Get the constraint for a handle, or nullptr if the handle is unset or stale
+	FConstraintInstance* GetConstraintInstance(const FConstraintHandle& Handle) const
+	{
+		return (Handle.Serial == PhysicsStateSerial && Constraints.IsValidIndex(Handle.Index)) ? Constraints[Handle.Index] : nullptr;
+	}
+
 	FSkeletalMeshComponentClothTickFunction ClothTickFunction;
 
 	/**
@@ -1607,13 +1864,29 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	ENGINE_API void OnPlasticDeformationWrapper(int32 ConstraintIndex);
 
 	/**
-	* Morph Target Curves. 
-	* This will override AnimInstance MorphTargetCurves if same curve is found
+	* Morph Target Curves set by name for morph targets the current mesh does not have. Resolved into
+	* MorphTargetWeights (and removed from here) when the mesh changes to one that has them
 	**/
 	TMap<FName, float> MorphTargetCurves;
 
+	/**
+	* Weights of morph targets set on this component, by name or by handle, indexed by morph target index on the
+	* current mesh. The single source of truth for component set weights: these override AnimInstance morph target
+	* curves of the same name in RefreshMorphTargets, and the CPU skinning path applies MorphTargetWeights.ActiveIndices
+	**/
+	FMorphTargetWeights MorphTargetWeights;
+
+	//Name view of MorphTargetWeights plus MorphTargetCurves for GetMorphTargetCurves, rebuilt when MorphTargetWeightsRevision changes
+	mutable TMap<FName, float> MorphTargetCurvesView;
+	mutable uint32 MorphTargetCurvesViewRevision = 0;
+	uint32 MorphTargetWeightsRevision = 1;
+
+	//Incremented when the mesh (and so the morph target indices) changes, used to detect stale FMorphTargetHandle
+	uint32 MorphTargetHandleSerial = 0;
+
     public: 
-	const TMap<FName, float>& GetMorphTargetCurves() const { return MorphTargetCurves;  }
+	//All component set morph target weights by name (MorphTargetWeights and unresolved MorphTargetCurves)
+	ENGINE_API const TMap<FName, float>& GetMorphTargetCurves() const;
 	//
 	//Animation
 	//
@@ -1760,7 +2033,45 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	ENGINE_API virtual void OnDestroyPhysicsState() override;
 	ENGINE_API virtual void SendRenderDynamicData_Concurrent() override;
 	ENGINE_API virtual void RegisterComponentTickFunctions(bool bRegister) override;
+
+	/**
+	* Quantize the LOD's ref-to-local matrices into QuantizedBones for the render proxy (bQuantizeBoneTransforms).
+	* Called from SendRenderDynamicData_Concurrent; returns false when a bone has non-uniform scale, in which case
+	* the frame is sent at full precision
+	**/
+	ENGINE_API bool PackQuantizedBoneTransforms_Concurrent(TArrayView<const FMatrix44f> InRefToLocals);
+
+	//Decode parameters and packed bones of the last quantized upload (one of the two arrays is used, per bHighPrecisionQuantizedBones)
+	FQuantizedBoneHeader QuantizedBoneHeader;
+	TArray<FQuantizedBone12> QuantizedBones12;
+	TArray<FQuantizedBone16> QuantizedBones16;
+
+	//Pose identity sent with the dynamic data when bShareIdenticalBoneBuffers is set; the render thread looks it up in FSkeletalMeshBoneBufferCache
+	FSkeletalMeshBonePoseKey BonePoseKey;
+
+	/**
+	* Advance VertexAnimationState from the closest view distance. Called at the start of TickComponent when
+	* bUseVertexAnimationLOD is set: switching to the texture starts it at the playing sequence's position and hides
+	* the skinned mesh; switching back sets the sequence to VertexAnimationState.SkeletalSeedTime (one delta behind
+	* the texture) before TickPose and evaluates it for one frame while the proxy is still visible (WarmingSkeletal),
+	* so the skinned mesh reappears on the texture's phase with a valid pose.
+	* While in Texture mode TickPose, RefreshBoneTransforms and SendRenderDynamicData_Concurrent are skipped and only
+	* the proxy's FrameA/FrameB/Alpha custom primitive data is updated
+	**/
+	ENGINE_API void UpdateVertexAnimationLOD(float DeltaTime);
+
+	//Create or destroy the proxy static mesh component as bUseVertexAnimationLOD / VertexAnimation change
+	ENGINE_API void UpdateVertexAnimationProxy();
+
+	FVertexAnimationPlaybackState VertexAnimationState;
+
+	//Static mesh component rendering VertexAnimation->ProxyMesh while the texture is visible, attached to this component
+	UPROPERTY(Transient)
+	TObjectPtr<UStaticMeshComponent> VertexAnimationProxy;
     public:
+	//Whether the character is currently driven by the animation texture only (no animation evaluation or skinning)
+	bool IsUsingVertexAnimation() const { return !VertexAnimationState.NeedsSkeletalEvaluation(); }
+
 	ENGINE_API virtual void InitializeComponent() override;
 	ENGINE_API virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 	ENGINE_API virtual void BeginPlay() override;
@@ -1784,11 +2095,41 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 
 	//~ Begin USceneComponent Interface
 	ENGINE_API virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+
+	/**
+	* Component space bounds from the cached per-bone boxes of the physics asset (see FSkeletalMeshBoneBounds), used by CalcBounds
+	* instead of iterating the body instances. Applies the expand-only mode when ExpandOnlyBoundsRefreshInterval is set.
+	* Returns an invalid box if there is no physics asset to build bone boxes from
+	**/
+	ENGINE_API FBox CalcBoundsFromBoneBounds() const;
 	ENGINE_API virtual bool IsAnySimulatingPhysics() const override;
 	ENGINE_API virtual void OnUpdateTransform(EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport = ETeleportType::None) override;
 	ENGINE_API virtual bool UpdateOverlapsImpl(const TOverlapArrayView* PendingOverlaps=NULL, bool bDoNotifies=true, const TOverlapArrayView* OverlapsAtEndLocation=NULL) override;
 	//~ End USceneComponent Interface
 
+	/**
+	* Overlap update used after FinalizeBoneTransform when bUseMotionThresholdedOverlaps is set.
+	* Queries only the bodies that moved beyond OverlapRefreshTolerance and diffs what those bodies found against what
+	* they found last time (FSkeletalMeshOverlapCache::Store): new overlaps are begun, overlaps no body of ours is
+	* attributed to any more are ended. Entries of OverlappingComponents owed to unmoved bodies are kept as they are,
+	* since other movers keep them current; nothing is replayed from the cache.
+	* Counts queries in STAT_SkelMeshBodyOverlapQueries / STAT_SkelMeshBodyOverlapQueriesSkipped (stat SkelMeshOverlaps)
+	**/
+	ENGINE_API bool UpdateOverlapsForMovedBodies(bool bDoNotifies = true);
+
+    private:
+	// Cached per-body overlap results for UpdateOverlapsForMovedBodies. Invalidated on teleport, collision changes and physics state re-creation 
+	FSkeletalMeshOverlapCache BodyOverlapCache;
+
+	// Per-bone local boxes of the current physics asset, resolved when the mesh or physics asset changes 
+	TSharedPtr<const FSkeletalMeshBoneBounds> CachedBoneBounds;
+
+	// Component space bounds kept by the expand-only mode and the frame they were last recomputed tight 
+	mutable FBox ExpandOnlyBounds = FBox(ForceInit);
+	mutable uint32 ExpandOnlyBoundsTightFrame = 0;
+
+    public:
+
 	//~ Begin UPrimitiveComponent Interface
     protected:
 	/**
@@ -1894,6 +2235,32 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	 ENGINE_API virtual bool SweepComponent( FHitResult& OutHit, const FVector Start, const FVector End, const FQuat& ShapRotation, const FCollisionShape& CollisionShape, bool bTraceComplex=false) override;
 	
 	ENGINE_API virtual bool OverlapComponent(const FVector& Pos, const FQuat& Rot, const FCollisionShape& CollisionShape) const override;
+
+	/**
+	* Trace many segments against this component. Rays are culled four at a time against the component bounds and then
+	* the bounds of each body, in float relative to the component location with conservatively inflated boxes
+	* (FRayPacket4::ToCullBox), and only surviving (ray, body) pairs run the same narrow phase as LineTraceComponent,
+	* so every hit is identical to the one LineTraceComponent would return for that segment.
+	* @param Starts: Start location per ray
+	* @param Ends: End location per ray, same size as Starts
+	* @param OutHits: Closest hit per ray, same size as Starts
+	* @return Number of rays that hit
+	**/
+	ENGINE_API int32 LineTraceComponentPacket(TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, const FCollisionQueryParams& Params, TArrayView<FHitResult> OutHits);
+
+	/**
+	* Sweep one shape along many segments against this component. Same culling as LineTraceComponentPacket with body
+	* bounds inflated by the shape extent; results match SweepComponent per segment
+	* @return Number of sweeps that hit
+	**/
+	ENGINE_API int32 SweepComponentPacket(TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, const FQuat& ShapeRotation, const FCollisionShape& CollisionShape, TArrayView<FHitResult> OutHits, bool bTraceComplex = false);
+
+	/**
+	* Trace many segments against many skeletal components, culling against component bounds first.
+	* OutHits receives the closest hit per ray over all components
+	* @return Number of rays that hit
+	**/
+	static ENGINE_API int32 LineTraceComponentsPacket(TArrayView<USkeletalMeshComponent* const> Components, TArrayView<const FVector> Starts, TArrayView<const FVector> Ends, const FCollisionQueryParams& Params, TArrayView<FHitResult> OutHits);
 	ENGINE_API virtual void SetSimulatePhysics(bool bEnabled) override;
 	ENGINE_API virtual void AddRadialImpulse(FVector Origin, float Radius, float Strength, ERadialImpulseFalloff Falloff, bool bVelChange=false) override;
 	ENGINE_API virtual void AddRadialForce(FVector Origin, float Radius, float Strength, ERadialImpulseFalloff Falloff, bool bAccelChange=false) override;
@@ -1921,6 +2288,32 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	ENGINE_API virtual float CalculateMass(FName BoneName = NAME_None) override;
 	ENGINE_API virtual bool DoCustomNavigableGeometryExport(FNavigableGeometryExport& GeomExport) const override;
 
+	/**
+	* If true, the navigable geometry of this component is exported from the reference pose, so it can be shared with every
+	* other component using the same physics asset and scale through FSkeletalNavGeometryCache. If false, the current pose
+	* is frozen into the cache key when exported
+	**/
+	UPROPERTY(EditAnywhere, AdvancedDisplay, Category = Navigation)
+	uint8 bExportNavGeometryInRefPose:1;
+
+	/** Key used to look this component up in FSkeletalNavGeometryCache */
+	ENGINE_API FSkeletalNavGeometryKey GetNavGeometryKey() const;
+
+	/**
+	* Start building this component's navigable geometry on a worker so a later DoCustomNavigableGeometryExport hits the cache.
+	* Called when the component registers with the navigation system; a no-op if the geometry is already cached
+	**/
+	ENGINE_API void PrewarmNavGeometryAsync();
+
+    private:
+	/**
+	* Frozen pose key this component holds a FSkeletalNavGeometryCache reference on. Swapped in
+	* DoCustomNavigableGeometryExport when the exported pose changes and released in OnUnregister
+	**/
+	mutable FSkeletalNavGeometryKey RetainedNavGeometryKey;
+
+    public:
+
 	/** 
 	* Add a force to all rigid bodies below. 
 	* This is like a 'thruster'. Good for adding a burst over some (non zero) time. Should be called every fram for the duration of the force
@@ -1998,6 +2391,40 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	
 	UE_DEPRECATED(5.1, "This method has been deprecated. Please use SetSkeletalMesh(NewMesh, false) instead.")
 	ENGINE_API void SetSkeletalMeshWithoutResettingAnimation(class USkeletalMesh* NewMesh);
+
+	/**
+	* Swap to a new mesh without a hitch. The bone container, required bones, curve filter and physics bodies of the new
+	* mesh are prepared on a worker while the current mesh keeps rendering and animating. The swap is committed on the
+	* game thread at the start of the next TickComponent after the data is ready, as a set of buffer swaps plus adding the
+	* prepared bodies to the scene. A later SetSkeletalMesh or SetSkeletalMeshAsync call cancels a pending swap.
+	*
+	* @param NewMesh: The new mesh; must be fully loaded
+	* @param bReinitPose: Whether to re-initialize the animation, as in SetSkeletalMesh
+	* @return Handle to query the swap with GetSkeletalMeshSwapState
+	**/
+	ENGINE_API FSkeletalMeshSwapHandle SetSkeletalMeshAsync(class USkeletalMesh* NewMesh, bool bReinitPose = true);
+
+	/** Get the state of a swap started with SetSkeletalMeshAsync */
+	ENGINE_API ESkeletalMeshSwapState GetSkeletalMeshSwapState(const FSkeletalMeshSwapHandle& Handle) const;
+
+	/** Cancel the pending asynchronous swap, if any. The payload, and the bodies and constraints it prepared, is freed when the task's result is released */
+	ENGINE_API void CancelPendingSkeletalMeshSwap();
+
+	/** Timing of the last committed asynchronous swap */
+	const FSkeletalMeshSwapStats& GetLastSkeletalMeshSwapStats() const { return LastSkeletalMeshSwapStats; }
+
+    private:
+	// Commit a prepared swap if one is ready. Called at the start of TickComponent 
+	ENGINE_API void CommitPendingSkeletalMeshSwap();
+
+	// Worker preparing the pending swap and the payload it fills 
+	UE::Tasks::TTask<TUniquePtr<FSkeletalMeshSwapPayload>> PendingSkeletalMeshSwapTask;
+	uint32 PendingSkeletalMeshSwapId = 0;
+	uint32 LastCommittedSkeletalMeshSwapId = 0;
+	uint32 PendingSkeletalMeshSwapStartFrame = 0;
+	FSkeletalMeshSwapStats LastSkeletalMeshSwapStats;
+
+    public:
 	
 	ENGINE_API virtual bool IsPlayingRootMotion() const override;
 	ENGINE_API virtual bool IsPlayingNetworkedRootMotionMontage() const override;
@@ -2151,6 +2578,13 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	UFUNCTION(BlueprintCallable, Category = "Physics")
 	ENGINE_API FVector GetBoneLinearVelocity(const FName& InBoneName);
 
+	/** Get the linear velocity of many bodies at once. Unset or stale handles give a zero velocity */
+	ENGINE_API void GetBoneLinearVelocities(TArrayView<const FBodyHandle> InBodies, TArrayView<FVector> OutVelocities) const;
+
+	/** Get the linear velocity of many bones at once, see GetBoneLinearVelocity */
+	UFUNCTION(BlueprintCallable, Category = "Physics")
+	ENGINE_API void GetBoneLinearVelocities(const TArray<FName>& InBoneNames, TArray<FVector>& OutVelocities);
+
 	/** Set all of the bones below passed in bone to be simulated */
 	UFUNCTION(BlueprintCallable, Category="Physics")
 	ENGINE_API void SetAllBodiesBelowSimulatePhysics(const FName& InBoneName, bool bNewSimulate, bool bIncludeSelf = true );
@@ -2212,6 +2646,19 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	/** Iterates over all bodies below and executes Func. Returns number of bodies found */
 	ENGINE_API int32 ForEachBodyBelow(FName BoneName, bool bIncludeSelf, bool bSkipCustomType, TFunctionRef<void(FBodyInstance*)> Func);
 
+	/**
+	* Get the indices into Bodies of all bodies below the named bone, as a contiguous slice of the depth-first body ordering.
+	* ForEachBodyBelow, the SetAllBodiesBelow* / AddXToAllBodiesBelow functions and GetTotalMassBelowBone are all built on this.
+	* Returns an empty view if the bone is unknown or physics has not been initialized.
+	**/
+	ENGINE_API TArrayView<const int32> GetBodyIndicesBelow(FName BoneName, bool bIncludeSelf) const;
+
+	/**
+	* Run Func over all bodies below the named bone with the physics scene write lock held once for the whole slice.
+	* Func must not take the lock itself. Returns number of bodies found
+	**/
+	ENGINE_API int32 ForEachBodyBelowLocked(FName BoneName, bool bIncludeSelf, bool bSkipCustomType, TFunctionRef<void(FBodyInstance*)> Func);
+
 	/**
 	* Change whethr to force mesh into ref post (and use cheaper vertex shader)
 	*
@@ -2321,6 +2768,18 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	UFUNCTION(BlueprintCallable, Category = "Physics")
 	ENGINE_API void GetCurrentJointAngles(FName InBoneName,float& Swing1Angle, float& TwistAngle, float& Swing2Angle) ;
 
+	/** Gets the current angular state of many constraints at once
+	*  @param InConstraints  Constraints to query, unset or stale handles give zero angles
+	*  @param OutAngles      Receives (Swing1, Twist, Swing2) per constraint, must be the same size as InConstraints
+	*/
+	ENGINE_API void GetCurrentJointAngles(TArrayView<const FConstraintHandle> InConstraints, TArrayView<FVector3f> OutAngles) const;
+
+	/** Gets the current angular state of many named bone constraints at once, see GetCurrentJointAngles
+	*  @param OutAngles      Receives (Swing1, Twist, Swing2) per bone
+	*/
+	UFUNCTION(BlueprintCallable, Category = "Physics")
+	ENGINE_API void GetCurrentJointAnglesForBones(const TArray<FName>& InBoneNames, TArray<FVector>& OutAngles);
+
 
 	/** iterates through all bodies in our PhysicsAsset and returns the location of the closest bone associated
 	 * with a body that has collision enabled.
@@ -2443,6 +2902,13 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	//Update systems after physics sim is done. 
 	ENGINE_API void EndPhysicsTickComponent(FSkeletalMeshComponentEndPhysicsTickFunction& ThisTickFunction);
 
+	/**
+	* EndPhysicsTickComponent for a component in the world's batched EndPhysics tick. The parallel blend completion
+	* task is chained onto the batch tick's completion handle (BlendInPhysicsInternal(BatchTickFunction)), which is
+	* what later ticks, the batched cloth tick included, wait on
+	**/
+	ENGINE_API void EndPhysicsTickComponent_Batched(FSkeletalMeshBatchedTickFunction& BatchTickFunction);
+
 	//Evaluate Anim System
 	ENGINE_API void EvaluateAnimation(const USkeletalMesh* InSkeletalMesh, UAnimInstance* InAnimInstance, bool bInForceRefPose, FVector& OutRootBoneTranslation, FBlendedHeapCurve& OutCurve, FCompactPose& OutPose, UE::Anim::FHeapAttributeContainer& OutAttributes) const;
 
@@ -2473,6 +2939,9 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	//Reference to our current blend physics task (if there is one)
 	FGraphEventRef				ParallelBlendPhysicsCompletionTask;
 
+	//Mesh name recorded by the task breadcrumbs (FScopedSkelMeshTaskBreadcrumb in each DoTask), refreshed by SetSkeletalMesh so workers never read the asset
+	FName TaskBreadcrumbMesh;
+
 	//Data for parallel evaluation of animation 
 	FAnimationEvaluationContext AnimEvaluationContext;
 
@@ -2518,12 +2987,24 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	//Returns whether we need to run the Pre Cloth Tick or not
 	ENGINE_API bool ShouldRunEndPhysicsTick() const;
 
-	//Handles registering/unregistering the pre cloth tick as it is needed
+	//Handles registering/unregistering the pre cloth tick as it is needed. With bUseBatchedPhysicsTicks this adds/removes the component from the world's batch
 	ENGINE_API void UpdateEndPhysicsTickRegisteredState();
 
-	//Handles registering/unregistering the cloth tick as it is needed
+	//Handles registering/unregistering the cloth tick as it is needed. With bUseBatchedPhysicsTicks this adds/removes the component from the world's batch
 	ENGINE_API void UpdateClothTickRegisteredState();
 
+	/**
+	* Whether the batched ticks can stand in for this component's own: no prerequisites on the EndPhysics or cloth
+	* tick beyond the ones the batch reproduces (PrimaryComponentTick, EndPhysics before cloth)
+	**/
+	ENGINE_API bool CanUseBatchedPhysicsTicks() const;
+
+	//Position in the world's batched EndPhysics / cloth tick arrays, INDEX_NONE when not batched
+	int32 BatchedTickIndices[static_cast<int32>(ESkeletalMeshBatchedTick::Num)] = { INDEX_NONE, INDEX_NONE };
+
+	//Pose published for GetPublishedPose, updated at the end of PostAnimEvaluation when bPublishPoseSnapshots is set
+	FSkeletalMeshPoseSnapshotSlot PublishedPose;
+
 	//Handles registering/unregistering the 'during animation' tick as it is needed
 	ENGINE_API void UpdateDuringAnimationTickRegisteredState();
 
@@ -2538,12 +3019,27 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	ENGINE_API void BlendInPhysicsInternal(FTickFunction& ThisTickFunction);
 
 	// Blends the simulation output with the component and bone space transforms coming from
-	// animation (just calls PerformBlendPhysicsBones)
-	void ParallelBlendPhysics() { PerformBlendPhysicsBones(RequiredBones, AnimEvaluationContext.ComponentSpaceTransforms, AnimEvaluationContext.BoneSpaceTransforms); }
+	// animation (just calls PerformBlendPhysicsBonesVectorized)
+	void ParallelBlendPhysics() { PerformBlendPhysicsBonesVectorized(RequiredBones, AnimEvaluationContext.ComponentSpaceTransforms, AnimEvaluationContext.BoneSpaceTransforms); }
 
 	// Blends the simulation output with the component and bone space transforms coming from animation
 	ENGINE_API void PerformBlendPhysicsBones(const TArray<FBoneIndexType>& InRequiredBones, TArray<FTransform>& InOutComponentSpaceTransforms, TArray<FTransform>& InOutBoneSpaceTransforms);
 
+	/**
+	* Vectorized version of PerformBlendPhysicsBones, used by ParallelBlendPhysics and BlendInPhysicsInternal.
+	* Body world transforms are gathered into PhysicsBlendBatch in SoA form, converted to component space and blended
+	* four at a time, then scattered back and local space is rebuilt parent-first in one pass.
+	* Bones whose body has full weight skip the blend, bones whose body has zero weight skip the gather.
+	* Falls back to PerformBlendPhysicsBones for local space kinematics.
+	**/
+	ENGINE_API void PerformBlendPhysicsBonesVectorized(const TArray<FBoneIndexType>& InRequiredBones, TArray<FTransform>& InOutComponentSpaceTransforms, TArray<FTransform>& InOutBoneSpaceTransforms);
+
+	// Partition InRequiredBones into full, partial and zero weight groups and gather the bodies we need. Returns false if nothing needs blending
+	ENGINE_API bool GatherPhysicsBlendBatch(const TArray<FBoneIndexType>& InRequiredBones, const TArray<FTransform>& InComponentSpaceTransforms, FPhysicsBlendBatch& OutBatch) const;
+
+	// Scratch data for PerformBlendPhysicsBonesVectorized, kept around to avoid per-frame allocations
+	FPhysicsBlendBatch PhysicsBlendBatch;
+
 	friend class FParallelClothTask;
 	// This is the parallel function that updates the cloth data and runs the simulation. This is safe to call from worker threads.
 	//static void ParallelEvaluateCloth(float DeltaTime, const FClothingActor& ClothingActor, const FClothSimulationContext& ClothSimulationContext);
@@ -2603,6 +3099,38 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 
 	/** Consume and return pending root motion from our internal anim instances (main, sub and post) */
 	ENGINE_API FRootMotionMovementParams ConsumeRootMotion();
+
+	/**
+	* Read the world space root motion extracted for this component during parallel evaluation (see FRootMotionBatch).
+	* Only valid when bUseBatchedRootMotion is set. Returns the previous frame's root motion (movement ticks before the
+	* mesh), false if none was produced
+	**/
+	ENGINE_API bool ConsumeBatchedRootMotion(FRootMotionMovementParams& OutRootMotion);
+
+	/**
+	* Whether bUseBatchedRootMotion can apply: false when the owner's CharacterMovementComponent consumes root motion
+	* itself (TickCharacterPose extracts it synchronously in the same frame), since the batch delivers it a frame late
+	**/
+	ENGINE_API bool CanUseBatchedRootMotion() const;
+
+	/**
+	* If true, root motion is consumed during the parallel evaluation task and converted to world space together with
+	* all other batched characters, instead of each movement component calling ConsumeRootMotion on the game thread.
+	* The result is read one frame late; ignored for characters whose CharacterMovement uses root motion (CanUseBatchedRootMotion)
+	**/
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadOnly, Category = Animation)
+	uint8 bUseBatchedRootMotion:1;
+
+	/**
+	* If true, component space transforms are only recomputed for the subtrees of bones whose local transform changed
+	* (see FSkeletalMeshIncrementalFK). A full evaluation still marks every bone; IK-only and additive-only updates
+	* and ApplyEditedComponentSpaceTransforms mark just the bones they write
+	**/
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadOnly, Category = Animation)
+	uint8 bUseIncrementalFK:1;
+
+	//Tell incremental FK that a bone's local transform was changed outside of evaluation
+	void MarkBoneTransformDirty(int32 BoneIndex) { IncrementalFK.MarkDirty(BoneIndex); }
 	
 	#if WITH_EDITOR
 		/** Called after modifying Component Space Transforms externally */
@@ -2614,6 +3142,16 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
 	/** Consume and return pending root motion from our internal anim instances (main, sub and post) */
 	ENGINE_API FRootMotionMovementParams ConsumeRootMotion_Internal(float InAlpha);
 
+	/**
+	* Consume root motion from the evaluation task and write it to this component's slot in the world FRootMotionBatch.
+	* Safe on worker threads. Does nothing until the slot is allocated (FRootMotionBatch::IsSlotAllocated); root motion
+	* is then left in the anim instances for ConsumeRootMotion
+	**/
+	ENGINE_API void ExtractRootMotionToBatch_AnyThread();
+
+	/** Slot in the world FRootMotionBatch, INDEX_NONE when batched root motion is not in use */
+	int32 RootMotionBatchSlot = INDEX_NONE;
+
     private:
 
 	#if WITH_EDIOR
@@ -2720,6 +3258,17 @@ class USkeletalMeshComponent : public USkinnedMeshComponent, public IInterface_C
     public: 
 	ENGINE_API void ConditionallyDispatchQueuedAnimEvents();
 
+	/**
+	* If true, queued anim notifies are handed to the world's FAnimNotifyBatchDispatcher from the evaluation task and
+	* dispatched in one batch per frame, instead of by this component in ConditionallyDispatchQueuedAnimEvents.
+	* The component joins the dispatcher (FAnimNotifyBatchDispatcher::AddComponent) when its tick is registered
+	**/
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadOnly, Category = Animation)
+	uint8 bUseBatchedAnimNotifyDispatch:1;
+
+	// Hand the notifies queued on our anim instances to the batch dispatcher. Safe on worker threads
+	ENGINE_API void QueueAnimEventsToBatch_AnyThread();
+
 	// Are we currently within PostAnimEvaluation
 	bool IsPostEvaluatingAnimation() const { return bPostEvaluatingAnimation; }
 
@@ -2748,6 +3297,7 @@ struct FLinkedInstancesAdapter
 		if (InComponent && InAnimInstance)
 		{
 			InComponent->LinkedInstances.AddUnique(InAnimInstance);
+			InComponent->RebuildLinkedInstanceIndex();
 		}
 	}
 
@@ -2756,6 +3306,7 @@ struct FLinkedInstancesAdapter
 		if (InComponent && InAnimInstance)
 		{
 			InComponent->LinkedInstances.Remove(InAnimInstance);
+			InComponent->RebuildLinkedInstanceIndex();
 		}
 	}
 
@@ -2764,6 +3315,7 @@ struct FLinkedInstancesAdapter
 		if (InComponent)
 		{
 			InComponent->LinkedInstances.Reset();
+			InComponent->RebuildLinkedInstanceIndex();
 		}
 	}
 };
@@ -0,0 +1,161 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/EngineTypes.h"
+
+#include "SkeletalMeshComponentPool.generated.h"
+
+class AActor;
+class UAnimInstance;
+class USkeletalMesh;
+class USkeletalMeshComponent;
+
+/** Spawn latency percentiles reported by USkeletalMeshComponentPool, in milliseconds */
+USTRUCT(BlueprintType)
+struct FSkeletalMeshPoolLatency
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = Pool)
+	float P50Ms = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = Pool)
+	float P90Ms = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = Pool)
+	float P99Ms = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = Pool)
+	int32 NumSamples = 0;
+
+	//Fraction of acquisitions served from the pool
+	UPROPERTY(BlueprintReadOnly, Category = Pool)
+	float HitRate = 0.f;
+};
+
+/**
+* Pool of fully initialized skeletal mesh components (and their anim instances) per (mesh, AnimClass).
+*
+* Acquiring from the pool skips OnRegister, InitializeComponent, InitAnim, InitializeAnimScriptInstance,
+* RegisterComponentTickFunctions and OnCreatePhysicsState: a pooled component stays registered and keeps its physics
+* state, with collision off, simulation off and ticking off. On reuse it is only re-attached, reset with
+* ResetForPoolReuse, and has its collision, simulation and tick restored. Prewarm spreads creation over frames within
+* PrewarmBudgetMs so streaming a town cell does not hitch.
+*
+* Ownership: a pooled component is outered to and owned by PoolHolder. Acquire renames it into InOwner and adds it to
+* InOwner's owned components, so GetOwner() and the actor's component list are correct; Release moves it back. If the
+* owner ends play while holding a component, the pool releases it back from the owner's OnEndPlay, before the actor
+* is destroyed, so the component is never destroyed with it. A component destroyed explicitly (DestroyComponent) is
+* dropped from the pool instead of being returned.
+**/
+UCLASS(MinimalAPI)
+class USkeletalMeshComponentPool : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	* Get a component for the mesh and anim class, attached to InOwner's root. Creates one if the pool is empty.
+	* @param InMesh: Mesh to display
+	* @param InAnimClass: Anim instance class, may be null for no animation blueprint
+	* @param InOwner: Actor that will own (and outer) the component until Release or until it ends play
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Components|SkeletalMesh|Pool")
+	ENGINE_API USkeletalMeshComponent* Acquire(USkeletalMesh* InMesh, TSubclassOf<UAnimInstance> InAnimClass, AActor* InOwner);
+
+	/**
+	* Return a component to the pool. It is detached, hidden, stops ticking, has collision and simulation turned off
+	* (its physics state is kept) and is renamed back into PoolHolder
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Components|SkeletalMesh|Pool")
+	ENGINE_API void Release(USkeletalMeshComponent* InComponent);
+
+	/**
+	* Queue creation of InCount initialized components for the mesh and anim class. Creation happens over the next frames,
+	* at most PrewarmBudgetMs of game thread time per frame; mesh and anim class loading is requested asynchronously first
+	**/
+	UFUNCTION(BlueprintCallable, Category = "Components|SkeletalMesh|Pool")
+	ENGINE_API void PrewarmAsync(TSoftObjectPtr<USkeletalMesh> InMesh, TSoftClassPtr<UAnimInstance> InAnimClass, int32 InCount);
+
+	/** Spawn latency percentiles over the last LatencyWindow acquisitions */
+	UFUNCTION(BlueprintCallable, Category = "Components|SkeletalMesh|Pool")
+	ENGINE_API FSkeletalMeshPoolLatency GetSpawnLatency() const;
+
+	/** Destroy every pooled (not acquired) component */
+	UFUNCTION(BlueprintCallable, Category = "Components|SkeletalMesh|Pool")
+	ENGINE_API void Trim();
+
+	//Game thread milliseconds per frame spent on prewarm creation
+	UPROPERTY(EditAnywhere, Category = Pool)
+	float PrewarmBudgetMs = 1.f;
+
+	//Maximum pooled components per (mesh, AnimClass); releases beyond this destroy the component
+	UPROPERTY(EditAnywhere, Category = Pool)
+	int32 MaxPooledPerKey = 64;
+
+	//Number of acquisitions kept for latency percentiles
+	UPROPERTY(EditAnywhere, Category = Pool)
+	int32 LatencyWindow = 1024;
+
+	//~ Begin UTickableWorldSubsystem Interface
+	ENGINE_API virtual void Tick(float DeltaTime) override;
+	ENGINE_API virtual TStatId GetStatId() const override;
+	ENGINE_API virtual void Deinitialize() override;
+	//~ End UTickableWorldSubsystem Interface
+
+private:
+	struct FPoolKey
+	{
+		TObjectKey<USkeletalMesh> Mesh;
+		TObjectKey<UClass> AnimClass;
+
+		bool operator==(const FPoolKey& Other) const { return Mesh == Other.Mesh && AnimClass == Other.AnimClass; }
+		friend uint32 GetTypeHash(const FPoolKey& Key) { return HashCombine(GetTypeHash(Key.Mesh), GetTypeHash(Key.AnimClass)); }
+	};
+
+	struct FPrewarmRequest
+	{
+		TSoftObjectPtr<USkeletalMesh> Mesh;
+		TSoftClassPtr<UAnimInstance> AnimClass;
+		int32 Remaining = 0;
+	};
+
+	//Create a registered, initialized, dormant component for the key. Owned by the subsystem's holder actor until acquired
+	USkeletalMeshComponent* CreatePooledComponent(USkeletalMesh* InMesh, TSubclassOf<UAnimInstance> InAnimClass);
+
+	//Record an acquisition latency sample
+	void AddLatencySample(double InMs, bool bHit);
+
+	//Release every component still acquired by an actor that ends play
+	UFUNCTION()
+	void OnOwnerEndPlay(AActor* InActor, EEndPlayReason::Type InEndPlayReason);
+
+	TMap<FPoolKey, TArray<TObjectPtr<USkeletalMeshComponent>>> Pooled;
+
+	//Actor that owns pooled components while they are not acquired
+	UPROPERTY(Transient)
+	TObjectPtr<AActor> PoolHolder;
+
+	//All pooled components, so the garbage collector keeps them alive
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USkeletalMeshComponent>> AllPooled;
+
+	//Acquired components per owner, released back in OnOwnerEndPlay
+	TMap<TObjectKey<AActor>, TArray<TWeakObjectPtr<USkeletalMeshComponent>>> Acquired;
+
+	//Collision setting of each component before Release turned it off, restored by Acquire
+	TMap<TObjectKey<USkeletalMeshComponent>, TEnumAsByte<ECollisionEnabled::Type>> SavedCollision;
+
+	TArray<FPrewarmRequest> PrewarmQueue;
+
+	//Ring buffer of acquisition latencies
+	TArray<float> LatencySamples;
+	int32 NextLatencySample = 0;
+	int32 NumHits = 0;
+	int32 NumAcquisitions = 0;
+};
@@ -0,0 +1,290 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/SoftObjectPath.h"
+#include "Engine/EngineTypes.h"
+#include "UObject/GCObject.h"
+
+class UAnimMontage;
+class USkeletalMeshComponent;
+class UWorld;
+
+/** Kinds of per-frame input captured by FSkelMeshFrameRecorder */
+enum class ESkelMeshFrameInput : uint8
+{
+	//Start of a frame: DeltaTime, random seed
+	Frame,
+	//Component moved: transform and teleport type
+	Transform,
+	//Montage started on the component's main anim instance: montage index, play rate, start position
+	MontagePlay,
+	//SetPosition on the single node instance: position, bFireNotifies
+	SetPosition,
+	//SetPlayRate on the single node instance
+	PlayRate,
+	//SetPhysicsBlendWeight / SetAllBodiesPhysicsBlendWeight: weight, all bodies flag
+	PhysicsBlendWeight,
+	Num
+};
+
+/**
+* Recorded workload: how to rebuild each component and the packed per-frame input stream.
+* Saved as a small binary file (magic, version, component setups, then the input bytes).
+**/
+struct FSkelMeshRecording
+{
+	static constexpr uint32 Magic = 0x52524B53; //'SKRR'
+	static constexpr uint32 Version = 1;
+
+	struct FComponentSetup
+	{
+		FSoftObjectPath Mesh;
+		FSoftClassPath AnimClass;
+		FTransform InitialTransform;
+		FName Name;
+	};
+
+	TArray<FComponentSetup> Components;
+
+	//Montages referenced by MontagePlay inputs
+	TArray<FSoftObjectPath> Montages;
+
+	//Packed inputs, read with FSkelMeshFrameInputReader
+	TArray<uint8> Inputs;
+
+	int32 NumFrames = 0;
+
+	ENGINE_API bool SaveToFile(const FString& InFilename) const;
+	ENGINE_API bool LoadFromFile(const FString& InFilename);
+
+	friend ENGINE_API FArchive& operator<<(FArchive& Ar, FSkelMeshRecording& Recording);
+};
+
+/**
+* Append-only writer for the input stream. Each input is a type byte, a component slot byte and a fixed payload;
+* transforms are stored as float quaternion/translation/scale (40 bytes) since replays compare timings, not positions.
+**/
+struct FSkelMeshFrameInputWriter
+{
+	TArray<uint8>& Bytes;
+
+	explicit FSkelMeshFrameInputWriter(TArray<uint8>& InBytes) : Bytes(InBytes) {}
+
+	template<typename T>
+	void Write(const T& InValue)
+	{
+		static_assert(TIsTriviallyCopyable<T>::Value, "Inputs are raw bytes");
+		const int32 Offset = Bytes.AddUninitialized(sizeof(T));
+		FMemory::Memcpy(Bytes.GetData() + Offset, &InValue, sizeof(T));
+	}
+
+	void WriteHeader(ESkelMeshFrameInput InType, uint8 InSlot)
+	{
+		Write(static_cast<uint8>(InType));
+		Write(InSlot);
+	}
+
+	void WriteTransform(const FTransform& InTransform)
+	{
+		Write(FQuat4f(InTransform.GetRotation()));
+		Write(FVector3f(InTransform.GetTranslation()));
+		Write(FVector3f(InTransform.GetScale3D()));
+	}
+};
+
+/** Reader over FSkelMeshRecording::Inputs. Reads past the end return zeros and set bError */
+struct FSkelMeshFrameInputReader
+{
+	TArrayView<const uint8> Bytes;
+	int32 Offset = 0;
+	bool bError = false;
+
+	explicit FSkelMeshFrameInputReader(TArrayView<const uint8> InBytes) : Bytes(InBytes) {}
+
+	bool AtEnd() const { return Offset >= Bytes.Num(); }
+
+	template<typename T>
+	T Read()
+	{
+		T Value{};
+		if (Offset + int32(sizeof(T)) > Bytes.Num())
+		{
+			bError = true;
+			Offset = Bytes.Num();
+			return Value;
+		}
+		FMemory::Memcpy(&Value, Bytes.GetData() + Offset, sizeof(T));
+		Offset += sizeof(T);
+		return Value;
+	}
+
+	FTransform ReadTransform()
+	{
+		const FQuat4f Rotation = Read<FQuat4f>();
+		const FVector3f Translation = Read<FVector3f>();
+		const FVector3f Scale = Read<FVector3f>();
+		return FTransform(FQuat(Rotation), FVector(Translation), FVector(Scale));
+	}
+};
+
+/**
+* Captures the per-frame inputs of selected components: delta times, teleports and moves, montage starts,
+* SetPosition/SetPlayRate calls and physics blend weight changes. Components with a recorder set (see
+* USkeletalMeshComponent::SetFrameRecorder) report their inputs from the functions that apply them; the frame
+* marker is written from FWorldDelegates::OnWorldTickStart.
+**/
+class FSkelMeshFrameRecorder
+{
+public:
+	FSkelMeshFrameRecorder() = default;
+
+	//Writer references Recording.Inputs, so a copy would write into the original's buffer
+	FSkelMeshFrameRecorder(const FSkelMeshFrameRecorder&) = delete;
+	FSkelMeshFrameRecorder& operator=(const FSkelMeshFrameRecorder&) = delete;
+
+	//Start capturing InComponents. Their current mesh, anim class and transform become the recording's setup
+	ENGINE_API void Start(UWorld* InWorld, TArrayView<USkeletalMeshComponent* const> InComponents);
+
+	//Stop capturing, detach from the components and return the recording
+	ENGINE_API FSkelMeshRecording Stop();
+
+	bool IsRecording() const { return bRecording; }
+
+	ENGINE_API void RecordFrame(float InDeltaTime);
+	ENGINE_API void RecordMontagePlay(const USkeletalMeshComponent* InComponent, const UAnimMontage* InMontage, float InPlayRate, float InStartPosition);
+
+	void RecordTransform(const USkeletalMeshComponent* InComponent, const FTransform& InTransform, ETeleportType InTeleport)
+	{
+		uint8 Slot;
+		if (FindSlot(InComponent, Slot))
+		{
+			Writer.WriteHeader(ESkelMeshFrameInput::Transform, Slot);
+			Writer.WriteTransform(InTransform);
+			Writer.Write(static_cast<uint8>(InTeleport));
+		}
+	}
+
+	void RecordSetPosition(const USkeletalMeshComponent* InComponent, float InPosition, bool bInFireNotifies)
+	{
+		uint8 Slot;
+		if (FindSlot(InComponent, Slot))
+		{
+			Writer.WriteHeader(ESkelMeshFrameInput::SetPosition, Slot);
+			Writer.Write(InPosition);
+			Writer.Write(static_cast<uint8>(bInFireNotifies));
+		}
+	}
+
+	void RecordPlayRate(const USkeletalMeshComponent* InComponent, float InRate)
+	{
+		uint8 Slot;
+		if (FindSlot(InComponent, Slot))
+		{
+			Writer.WriteHeader(ESkelMeshFrameInput::PlayRate, Slot);
+			Writer.Write(InRate);
+		}
+	}
+
+	void RecordPhysicsBlendWeight(const USkeletalMeshComponent* InComponent, float InWeight, bool bInAllBodies)
+	{
+		uint8 Slot;
+		if (FindSlot(InComponent, Slot))
+		{
+			Writer.WriteHeader(ESkelMeshFrameInput::PhysicsBlendWeight, Slot);
+			Writer.Write(InWeight);
+			Writer.Write(static_cast<uint8>(bInAllBodies));
+		}
+	}
+
+private:
+	bool FindSlot(const USkeletalMeshComponent* InComponent, uint8& OutSlot) const
+	{
+		const uint8* Slot = bRecording ? Slots.Find(InComponent) : nullptr;
+		OutSlot = Slot ? *Slot : 0;
+		return Slot != nullptr;
+	}
+
+	FSkelMeshRecording Recording;
+	FSkelMeshFrameInputWriter Writer{ Recording.Inputs };
+
+	//Recorded components (at most 256 per recording)
+	TMap<TObjectKey<USkeletalMeshComponent>, uint8> Slots;
+	TArray<TWeakObjectPtr<USkeletalMeshComponent>> Components;
+
+	TMap<TObjectKey<UAnimMontage>, uint16> MontageIndices;
+	FDelegateHandle WorldTickHandle;
+	TWeakObjectPtr<UWorld> World;
+	bool bRecording = false;
+};
+
+/** Timings of one replay, per stage, in milliseconds of game thread time for all components of a frame */
+struct FSkelMeshReplayStats
+{
+	TArray<float> TickAnimationMs;
+	TArray<float> RefreshBoneTransformsMs;
+	TArray<float> EndPhysicsTickMs;
+
+	//Value at InPercentile (0..1) of a stage's per-frame times
+	static float GetPercentile(TArrayView<const float> InTimes, float InPercentile)
+	{
+		if (InTimes.Num() == 0)
+		{
+			return 0.f;
+		}
+		TArray<float> Sorted(InTimes.GetData(), InTimes.Num());
+		Sorted.Sort();
+		return Sorted[FMath::Clamp(FMath::FloorToInt32(InPercentile * (Sorted.Num() - 1) + 0.5f), 0, Sorted.Num() - 1)];
+	}
+
+	//Header line and one line per frame, for comparing two builds in a spreadsheet
+	ENGINE_API FString ToCsv() const;
+};
+
+/**
+* Re-drives a recording headlessly: spawns one component per setup in InWorld, then for every recorded frame applies
+* the frame's inputs and calls TickAnimation, RefreshBoneTransforms and EndPhysicsTickComponent directly, in that
+* order, timing each stage. Parallel animation evaluation is forced off so stage times are not hidden in task waits,
+* and the recorded random seed is restored before each frame so random sequence players pick the same animations.
+* The spawned components and loaded montages are reported to garbage collection for as long as the replayer lives.
+**/
+class FSkelMeshFrameReplayer : public FGCObject
+{
+public:
+	FSkelMeshFrameReplayer() = default;
+	FSkelMeshFrameReplayer(const FSkelMeshFrameReplayer&) = delete;
+	FSkelMeshFrameReplayer& operator=(const FSkelMeshFrameReplayer&) = delete;
+
+	//Load assets and spawn the components. Returns false when an asset in the recording cannot be loaded
+	ENGINE_API bool Setup(UWorld* InWorld, const FSkelMeshRecording& InRecording);
+
+	//Replay every frame InIterations times and accumulate stage timings
+	ENGINE_API FSkelMeshReplayStats Run(int32 InIterations = 1);
+
+	//Destroy the spawned components
+	ENGINE_API void Teardown();
+
+	//~ Begin FGCObject Interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+	{
+		Collector.AddReferencedObjects(Components);
+		Collector.AddReferencedObjects(Montages);
+	}
+
+	virtual FString GetReferencerName() const override
+	{
+		return TEXT("FSkelMeshFrameReplayer");
+	}
+	//~ End FGCObject Interface
+
+private:
+	//Apply inputs up to the next frame marker; returns false at the end of the stream
+	bool ApplyNextFrame(FSkelMeshFrameInputReader& InReader, float& OutDeltaTime);
+
+	const FSkelMeshRecording* Recording = nullptr;
+	TArray<TObjectPtr<USkeletalMeshComponent>> Components;
+	TArray<TObjectPtr<UAnimMontage>> Montages;
+	TWeakObjectPtr<UWorld> World;
+};
@@ -0,0 +1,244 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* Incremental local-to-component space conversion over the required bones of one LOD.
+*
+* Required bones are stored in depth-first order so the subtree of any bone is the contiguous slot range
+* [Slot, SubtreeEnd[Slot]), parents before children. Writers mark the bones whose local transform they changed;
+* Update then recomputes only the marked subtrees, jumping over clean slots a word of the dirty bit array at a time.
+*
+* Clean slots are only valid in the buffer the previous Update wrote. Component space transforms are double buffered
+* (SwapEvaluationContextBuffers), so Update remembers the buffer it last wrote and, when handed another one, first
+* copies the required bones across from InPreviousComponentSpace, or recomputes everything if that is not supplied.
+*
+* When the root bone's local transform is the only one that changed (a procedural root offset or root-only layer over
+* an otherwise unchanged pose) and its scale is uniform, every other bone is RelativeToRoot * Root: one multiply per
+* bone with no dependency on the parent's result. Moving the component itself (root motion, teleports, a capsule
+* moving) does not touch any bone and needs no Update at all.
+* RelativeToRoot is maintained lazily, only for the subtrees the general path touched since it was last used. A full
+* evaluation (MarkAllDirty) always takes the general path, which also marks every relative transform stale.
+**/
+struct FSkeletalMeshIncrementalFK
+{
+	//Mesh bone index per slot, in depth-first order
+	TArray<FBoneIndexType> SlotBones;
+
+	//Slot of the parent bone per slot, INDEX_NONE for the root
+	TArray<int32> ParentSlots;
+
+	//Exclusive end of each slot's subtree
+	TArray<int32> SubtreeEnd;
+
+	//Slot per mesh bone, INDEX_NONE for bones not required at this LOD
+	TArray<int32> BoneToSlot;
+
+	//Slots whose local transform changed since the last Update
+	TBitArray<> LocalDirty;
+	int32 NumLocalDirty = 0;
+
+	//Set by MarkAllDirty (full evaluation): every local transform may have changed, so the root only path is not valid
+	bool bAllDirty = false;
+
+	//Component space transform of each slot relative to the root, and slots where it is out of date
+	TArray<FTransform> RelativeToRoot;
+	TBitArray<> RelativeToRootStale;
+
+	//Buffer the last Update wrote; clean slots are only valid there
+	const FTransform* LastOutput = nullptr;
+
+	//Bones recomputed by the last Update and whether it took the root only path
+	int32 LastNumRecomputed = 0;
+	bool bLastUsedRootFastPath = false;
+
+	bool IsBuilt() const { return SlotBones.Num() > 0; }
+
+	/**
+	* Build the slot order for a set of required bones. Everything starts dirty.
+	* @param InRequiredBones: Required mesh bone indices, parents included (as FillComponentSpaceTransformsRequiredBones)
+	* @param InParentIndices: Parent per mesh bone (INDEX_NONE for the root), from the reference skeleton
+	**/
+	void Build(TArrayView<const FBoneIndexType> InRequiredBones, TArrayView<const int32> InParentIndices)
+	{
+		const int32 NumBones = InParentIndices.Num();
+		const int32 NumRequired = InRequiredBones.Num();
+
+		BoneToSlot.Init(INDEX_NONE, NumBones);
+		TArray<int32> FirstChild;
+		FirstChild.SetNumZeroed(NumBones + 1);
+		for (FBoneIndexType Bone : InRequiredBones)
+		{
+			if (InParentIndices[Bone] != INDEX_NONE)
+			{
+				++FirstChild[InParentIndices[Bone] + 1];
+			}
+		}
+		for (int32 Bone = 0; Bone < NumBones; ++Bone)
+		{
+			FirstChild[Bone + 1] += FirstChild[Bone];
+		}
+		TArray<int32> Children;
+		Children.SetNumUninitialized(FirstChild[NumBones]);
+		TArray<int32> Cursor(FirstChild);
+		for (FBoneIndexType Bone : InRequiredBones)
+		{
+			if (InParentIndices[Bone] != INDEX_NONE)
+			{
+				Children[Cursor[InParentIndices[Bone]]++] = Bone;
+			}
+		}
+
+		SlotBones.Reset(NumRequired);
+		ParentSlots.Reset(NumRequired);
+		SubtreeEnd.SetNumUninitialized(NumRequired);
+
+		//Iterative depth-first walk, a negative entry on the stack closes the subtree of slot ~Entry
+		TArray<int32> Stack;
+		for (int32 It = NumRequired - 1; It >= 0; --It)
+		{
+			if (InParentIndices[InRequiredBones[It]] == INDEX_NONE)
+			{
+				Stack.Push(InRequiredBones[It]);
+			}
+		}
+		while (Stack.Num() > 0)
+		{
+			const int32 Entry = Stack.Pop(EAllowShrinking::No);
+			if (Entry < 0)
+			{
+				SubtreeEnd[~Entry] = SlotBones.Num();
+				continue;
+			}
+
+			const int32 Slot = SlotBones.Add(static_cast<FBoneIndexType>(Entry));
+			const int32 Parent = InParentIndices[Entry];
+			ParentSlots.Add(Parent != INDEX_NONE ? BoneToSlot[Parent] : INDEX_NONE);
+			BoneToSlot[Entry] = Slot;
+			Stack.Push(~Slot);
+			for (int32 ChildIt = FirstChild[Entry + 1] - 1; ChildIt >= FirstChild[Entry]; --ChildIt)
+			{
+				Stack.Push(Children[ChildIt]);
+			}
+		}
+
+		RelativeToRoot.SetNum(SlotBones.Num());
+		RelativeToRootStale.Init(true, SlotBones.Num());
+		MarkAllDirty();
+	}
+
+	//Mark a bone whose local transform changed. Its whole subtree is recomputed on the next Update
+	void MarkDirty(int32 InBoneIndex)
+	{
+		const int32 Slot = BoneToSlot.IsValidIndex(InBoneIndex) ? BoneToSlot[InBoneIndex] : INDEX_NONE;
+		if (Slot != INDEX_NONE && !LocalDirty[Slot])
+		{
+			LocalDirty[Slot] = true;
+			++NumLocalDirty;
+		}
+	}
+
+	void MarkAllDirty()
+	{
+		LocalDirty.Init(false, SlotBones.Num());
+		NumLocalDirty = 0;
+		bAllDirty = true;
+		if (SlotBones.Num() > 0)
+		{
+			//Every slot is in the subtree of slot 0 when the skeleton has a single root
+			for (int32 Slot = 0; Slot < SlotBones.Num(); Slot = SubtreeEnd[Slot])
+			{
+				LocalDirty[Slot] = true;
+				++NumLocalDirty;
+			}
+		}
+	}
+
+	/**
+	* Bring InOutComponentSpace up to date with InLocalSpace for every dirty subtree, then clear the dirty state.
+	* Both arrays are indexed by mesh bone index, like BoneSpaceTransforms / ComponentSpaceTransforms.
+	* @param InPreviousComponentSpace: The other buffer of the double buffered pair. Used when InOutComponentSpace is
+	* not the buffer the last Update wrote: if this one is, its required bones are copied across first; otherwise
+	* (or when empty) every bone is recomputed
+	**/
+	void Update(TArrayView<const FTransform> InLocalSpace, TArrayView<FTransform> InOutComponentSpace, TArrayView<const FTransform> InPreviousComponentSpace = TArrayView<const FTransform>())
+	{
+		LastNumRecomputed = 0;
+		bLastUsedRootFastPath = false;
+		if (InOutComponentSpace.GetData() != LastOutput)
+		{
+			if (LastOutput && InPreviousComponentSpace.GetData() == LastOutput && InPreviousComponentSpace.Num() == InOutComponentSpace.Num())
+			{
+				for (FBoneIndexType Bone : SlotBones)
+				{
+					InOutComponentSpace[Bone] = InPreviousComponentSpace[Bone];
+				}
+			}
+			else
+			{
+				MarkAllDirty();
+			}
+			LastOutput = InOutComponentSpace.GetData();
+		}
+		if (NumLocalDirty == 0)
+		{
+			return;
+		}
+
+		const FTransform& RootLocal = InLocalSpace[SlotBones[0]];
+		if (!bAllDirty && NumLocalDirty == 1 && LocalDirty[0] && SubtreeEnd[0] == SlotBones.Num() && RootLocal.GetScale3D().AllComponentsEqual())
+		{
+			UpdateRootOnly(InLocalSpace, InOutComponentSpace);
+		}
+		else
+		{
+			for (int32 Slot = LocalDirty.FindFrom(true, 0); Slot != INDEX_NONE && Slot < SlotBones.Num(); Slot = LocalDirty.FindFrom(true, Slot))
+			{
+				const int32 End = SubtreeEnd[Slot];
+				for (int32 It = Slot; It < End; ++It)
+				{
+					const int32 Bone = SlotBones[It];
+					const int32 ParentSlot = ParentSlots[It];
+					InOutComponentSpace[Bone] = ParentSlot == INDEX_NONE ? InLocalSpace[Bone] : InLocalSpace[Bone] * InOutComponentSpace[SlotBones[ParentSlot]];
+				}
+				LastNumRecomputed += End - Slot;
+
+				//The root's relative transform is always identity
+				RelativeToRootStale.SetRange(FMath::Max(Slot, 1), End - FMath::Max(Slot, 1), true);
+				if (End >= SlotBones.Num())
+				{
+					break;
+				}
+				Slot = End;
+			}
+		}
+
+		LocalDirty.SetRange(0, LocalDirty.Num(), false);
+		NumLocalDirty = 0;
+		bAllDirty = false;
+	}
+
+private:
+	void UpdateRootOnly(TArrayView<const FTransform> InLocalSpace, TArrayView<FTransform> InOutComponentSpace)
+	{
+		//Refresh relative-to-root transforms of the subtrees the general path changed since the last fast update
+		for (int32 Slot = RelativeToRootStale.FindFrom(true, 1); Slot != INDEX_NONE; Slot = RelativeToRootStale.FindFrom(true, Slot + 1))
+		{
+			const int32 Bone = SlotBones[Slot];
+			const int32 ParentSlot = ParentSlots[Slot];
+			RelativeToRoot[Slot] = ParentSlot == 0 ? InLocalSpace[Bone] : InLocalSpace[Bone] * RelativeToRoot[ParentSlot];
+			RelativeToRootStale[Slot] = false;
+		}
+
+		const FTransform Root = InLocalSpace[SlotBones[0]];
+		InOutComponentSpace[SlotBones[0]] = Root;
+		for (int32 Slot = 1; Slot < SlotBones.Num(); ++Slot)
+		{
+			InOutComponentSpace[SlotBones[Slot]] = RelativeToRoot[Slot] * Root;
+		}
+		LastNumRecomputed = SlotBones.Num();
+		bLastUsedRootFastPath = true;
+	}
+};
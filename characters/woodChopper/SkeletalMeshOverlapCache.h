@@ -0,0 +1,120 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Engine/OverlapInfo.h"
+#include "UObject/ObjectKey.h"
+
+DECLARE_STATS_GROUP(TEXT("Skeletal Mesh Overlaps"), STATGROUP_SkelMeshOverlaps, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Body Overlap Queries"), STAT_SkelMeshBodyOverlapQueries, STATGROUP_SkelMeshOverlaps, ENGINE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Body Overlap Queries Skipped"), STAT_SkelMeshBodyOverlapQueriesSkipped, STATGROUP_SkelMeshOverlaps, ENGINE_API);
+
+/**
+* Per-body overlap attribution of a skeletal mesh component, with the body bounds it was queried at.
+* After FinalizeBoneTransform only bodies whose bounds moved further than the tolerance are queried again.
+*
+* The cache never stands in for the component's overlap state: OverlappingComponents stays the live set, which other
+* movers keep updating through Begin/EndComponentOverlap. The cache only records which of our bodies found which
+* overlap at its last query, so that a moved body's results can be diffed against what that body contributed:
+* an overlap is begun if a moved body finds it and it is not live yet, and ended only when the last of our bodies
+* attributed to it stops finding it. Unmoved bodies' live entries are left untouched.
+**/
+struct FSkeletalMeshOverlapCache
+{
+	//Other component and body, as FOverlapInfo identifies an overlap
+	struct FOverlapKey
+	{
+		TObjectKey<UPrimitiveComponent> Component;
+		int32 Item = INDEX_NONE;
+
+		explicit FOverlapKey(const FOverlapInfo& InInfo)
+			: Component(InInfo.OverlapInfo.GetComponent())
+			, Item(InInfo.GetBodyIndex())
+		{
+		}
+
+		bool operator==(const FOverlapKey& Other) const { return Item == Other.Item && Component == Other.Component; }
+		friend uint32 GetTypeHash(const FOverlapKey& Key) { return HashCombine(GetTypeHash(Key.Component), ::GetTypeHash(Key.Item)); }
+	};
+
+	struct FBodyEntry
+	{
+		//World bounds of the body when it was last queried
+		FBox QueriedBounds = FBox(ForceInit);
+
+		//Overlaps found for the body at QueriedBounds
+		TArray<FOverlapInfo> Overlaps;
+
+		bool bValid = false;
+	};
+
+	TArray<FBodyEntry> Bodies;
+
+	//Number of our bodies whose last query found each overlap
+	TMap<FOverlapKey, int32> AttributionCount;
+
+	void Reset(int32 InNumBodies)
+	{
+		Bodies.Reset();
+		Bodies.SetNum(InNumBodies);
+		AttributionCount.Reset();
+	}
+
+	//Force every body to be queried again (teleport, collision change); the live overlap set is not touched
+	void Invalidate()
+	{
+		for (FBodyEntry& Entry : Bodies)
+		{
+			Entry.bValid = false;
+			Entry.Overlaps.Reset();
+		}
+		AttributionCount.Reset();
+	}
+
+	/**
+	* Whether a body must be queried again.
+	* The swept bounds are the union of the last queried and the current bounds: if either corner moved by more than
+	* InTolerance, the swept volume grew enough that the cached overlaps may be wrong.
+	**/
+	bool NeedsQuery(int32 InBodyIndex, const FBox& InCurrentBounds, float InTolerance) const
+	{
+		if (!Bodies.IsValidIndex(InBodyIndex) || !Bodies[InBodyIndex].bValid)
+		{
+			return true;
+		}
+		const FBox& Queried = Bodies[InBodyIndex].QueriedBounds;
+		const FVector::FReal ToleranceSquared = FMath::Square(InTolerance);
+		return FVector::DistSquared(Queried.Min, InCurrentBounds.Min) > ToleranceSquared
+			|| FVector::DistSquared(Queried.Max, InCurrentBounds.Max) > ToleranceSquared;
+	}
+
+	/**
+	* Replace a moved body's results with a fresh query.
+	* @param OutFound: Overlaps the body found; the caller begins those not yet in OverlappingComponents
+	* @param OutLost: Overlaps no body of ours is attributed to any more; the caller ends those still in OverlappingComponents
+	**/
+	void Store(int32 InBodyIndex, const FBox& InBounds, TArrayView<const FOverlapInfo> InOverlaps, TArray<FOverlapInfo>& OutFound, TArray<FOverlapInfo>& OutLost)
+	{
+		FBodyEntry& Entry = Bodies[InBodyIndex];
+		for (const FOverlapInfo& Overlap : InOverlaps)
+		{
+			++AttributionCount.FindOrAdd(FOverlapKey(Overlap));
+			OutFound.Add(Overlap);
+		}
+		for (const FOverlapInfo& Overlap : Entry.Overlaps)
+		{
+			const FOverlapKey Key(Overlap);
+			int32& Count = AttributionCount.FindChecked(Key);
+			if (--Count == 0)
+			{
+				AttributionCount.Remove(Key);
+				OutLost.Add(Overlap);
+			}
+		}
+		Entry.QueriedBounds = InBounds;
+		Entry.Overlaps = InOverlaps;
+		Entry.bValid = true;
+	}
+};
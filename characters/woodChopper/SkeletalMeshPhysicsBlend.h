@@ -0,0 +1,152 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/VectorRegister.h"
+
+/**
+* Structure-of-arrays storage for a batch of transforms, used by the vectorized physics blend.
+* Every channel is padded to a multiple of four lanes so the kernels never need a scalar tail.
+**/
+struct FTransformSoA
+{
+	static constexpr int32 Lanes = 4;
+
+	TArray<double> RotX, RotY, RotZ, RotW;
+	TArray<double> PosX, PosY, PosZ;
+	TArray<double> ScaleX, ScaleY, ScaleZ;
+
+	int32 Num() const { return NumTransforms; }
+
+	void Reset(int32 InNum)
+	{
+		NumTransforms = InNum;
+		const int32 Padded = Align(InNum, Lanes);
+		for (TArray<double>* Channel : { &RotX, &RotY, &RotZ, &RotW, &PosX, &PosY, &PosZ, &ScaleX, &ScaleY, &ScaleZ })
+		{
+			Channel->SetNumUninitialized(Padded, EAllowShrinking::No);
+		}
+		//Padding lanes hold identity so normalization never divides by zero
+		for (int32 Index = InNum; Index < Padded; ++Index)
+		{
+			Set(Index, FTransform::Identity);
+		}
+	}
+
+	void Set(int32 Index, const FTransform& InTransform)
+	{
+		const FQuat Rotation = InTransform.GetRotation();
+		const FVector Translation = InTransform.GetTranslation();
+		const FVector Scale = InTransform.GetScale3D();
+		RotX[Index] = Rotation.X; RotY[Index] = Rotation.Y; RotZ[Index] = Rotation.Z; RotW[Index] = Rotation.W;
+		PosX[Index] = Translation.X; PosY[Index] = Translation.Y; PosZ[Index] = Translation.Z;
+		ScaleX[Index] = Scale.X; ScaleY[Index] = Scale.Y; ScaleZ[Index] = Scale.Z;
+	}
+
+	FTransform Get(int32 Index) const
+	{
+		return FTransform(
+			FQuat(RotX[Index], RotY[Index], RotZ[Index], RotW[Index]),
+			FVector(PosX[Index], PosY[Index], PosZ[Index]),
+			FVector(ScaleX[Index], ScaleY[Index], ScaleZ[Index]));
+	}
+
+private:
+	int32 NumTransforms = 0;
+};
+
+/**
+* Per-evaluation scratch data for the vectorized physics blend.
+* Bones are partitioned once per blend: bones whose body has full weight take the physics transform as-is,
+* partially weighted bones go through the SoA blend, and bones whose body has zero weight are never gathered.
+**/
+struct FPhysicsBlendBatch
+{
+	//Bones whose physics transform replaces the animated one outright, and the body driving each of them
+	TArray<FBoneIndexType> FullWeightBones;
+	TArray<int32> FullWeightBodies;
+
+	//Bones that need a blend, the body driving each of them and the blend weight (padded like FTransformSoA)
+	TArray<FBoneIndexType> PartialWeightBones;
+	TArray<int32> PartialWeightBodies;
+	TArray<double> PartialWeights;
+
+	//Component space transforms of PartialWeightBones, animated and simulated
+	FTransformSoA Animated;
+	FTransformSoA Simulated;
+
+	void Reset()
+	{
+		FullWeightBones.Reset();
+		FullWeightBodies.Reset();
+		PartialWeightBones.Reset();
+		PartialWeightBodies.Reset();
+		PartialWeights.Reset();
+	}
+
+	bool IsEmpty() const { return FullWeightBones.Num() == 0 && PartialWeightBones.Num() == 0; }
+};
+
+namespace PhysicsBlend
+{
+	/**
+	* Blend InOutAnimated towards InSimulated by InWeights, four transforms at a time.
+	* Translation and scale are lerped, rotation is a shortest-path normalized lerp which matches FTransform::BlendWith.
+	* @param InOutAnimated: Animated transforms, receives the result
+	* @param InSimulated: Simulated transforms, same count and padding as InOutAnimated
+	* @param InWeights: Physics weight per transform, padded to a multiple of four
+	**/
+	inline void BlendTransformsSoA(FTransformSoA& InOutAnimated, const FTransformSoA& InSimulated, const double* InWeights)
+	{
+		const int32 Padded = Align(InOutAnimated.Num(), FTransformSoA::Lanes);
+		const VectorRegister4Double Zero = VectorZeroDouble();
+
+		auto Lerp = [](double* A, const double* B, const VectorRegister4Double& W)
+		{
+			const VectorRegister4Double VA = VectorLoad(A);
+			VectorStore(VectorMultiplyAdd(VectorSubtract(VectorLoad(B), VA), W, VA), A);
+		};
+
+		for (int32 Index = 0; Index < Padded; Index += FTransformSoA::Lanes)
+		{
+			const VectorRegister4Double W = VectorLoad(InWeights + Index);
+
+			Lerp(&InOutAnimated.PosX[Index], &InSimulated.PosX[Index], W);
+			Lerp(&InOutAnimated.PosY[Index], &InSimulated.PosY[Index], W);
+			Lerp(&InOutAnimated.PosZ[Index], &InSimulated.PosZ[Index], W);
+			Lerp(&InOutAnimated.ScaleX[Index], &InSimulated.ScaleX[Index], W);
+			Lerp(&InOutAnimated.ScaleY[Index], &InSimulated.ScaleY[Index], W);
+			Lerp(&InOutAnimated.ScaleZ[Index], &InSimulated.ScaleZ[Index], W);
+
+			const VectorRegister4Double AX = VectorLoad(&InOutAnimated.RotX[Index]);
+			const VectorRegister4Double AY = VectorLoad(&InOutAnimated.RotY[Index]);
+			const VectorRegister4Double AZ = VectorLoad(&InOutAnimated.RotZ[Index]);
+			const VectorRegister4Double AW = VectorLoad(&InOutAnimated.RotW[Index]);
+			VectorRegister4Double BX = VectorLoad(&InSimulated.RotX[Index]);
+			VectorRegister4Double BY = VectorLoad(&InSimulated.RotY[Index]);
+			VectorRegister4Double BZ = VectorLoad(&InSimulated.RotZ[Index]);
+			VectorRegister4Double BW = VectorLoad(&InSimulated.RotW[Index]);
+
+			//Flip the simulated rotation into the same hemisphere as the animated one
+			const VectorRegister4Double Dot = VectorMultiplyAdd(AX, BX, VectorMultiplyAdd(AY, BY, VectorMultiplyAdd(AZ, BZ, VectorMultiply(AW, BW))));
+			const VectorRegister4Double Flip = VectorCompareLT(Dot, Zero);
+			BX = VectorSelect(Flip, VectorNegate(BX), BX);
+			BY = VectorSelect(Flip, VectorNegate(BY), BY);
+			BZ = VectorSelect(Flip, VectorNegate(BZ), BZ);
+			BW = VectorSelect(Flip, VectorNegate(BW), BW);
+
+			const VectorRegister4Double QX = VectorMultiplyAdd(VectorSubtract(BX, AX), W, AX);
+			const VectorRegister4Double QY = VectorMultiplyAdd(VectorSubtract(BY, AY), W, AY);
+			const VectorRegister4Double QZ = VectorMultiplyAdd(VectorSubtract(BZ, AZ), W, AZ);
+			const VectorRegister4Double QW = VectorMultiplyAdd(VectorSubtract(BW, AW), W, AW);
+
+			const VectorRegister4Double SizeSquared = VectorMultiplyAdd(QX, QX, VectorMultiplyAdd(QY, QY, VectorMultiplyAdd(QZ, QZ, VectorMultiply(QW, QW))));
+			const VectorRegister4Double InvSize = VectorReciprocalSqrt(SizeSquared);
+			VectorStore(VectorMultiply(QX, InvSize), &InOutAnimated.RotX[Index]);
+			VectorStore(VectorMultiply(QY, InvSize), &InOutAnimated.RotY[Index]);
+			VectorStore(VectorMultiply(QZ, InvSize), &InOutAnimated.RotZ[Index]);
+			VectorStore(VectorMultiply(QW, InvSize), &InOutAnimated.RotW[Index]);
+		}
+	}
+}
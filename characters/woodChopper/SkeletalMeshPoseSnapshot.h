@@ -0,0 +1,130 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/ScopeRWLock.h"
+#include <atomic>
+
+/** Immutable pose published by a skeletal mesh component once an evaluation has completed */
+struct FSkeletalMeshPoseSnapshot
+{
+	//Local space (relative to parent bone) transforms, as GetBoneSpaceTransforms would return
+	TArray<FTransform> BoneSpaceTransforms;
+
+	//Component space transforms, as GetComponentSpaceTransforms would return
+	TArray<FTransform> ComponentSpaceTransforms;
+
+	FTransform ComponentToWorld;
+
+	//Publication counter of the owning component, starting at 1
+	uint64 Version = 0;
+
+	//GFrameCounter when the pose was published
+	uint64 FrameNumber = 0;
+
+	int32 LODIndex = INDEX_NONE;
+};
+
+using FSkeletalMeshPoseSnapshotPtr = TSharedPtr<const FSkeletalMeshPoseSnapshot, ESPMode::ThreadSafe>;
+
+/**
+* Publication point for FSkeletalMeshPoseSnapshot, read-copy-update style: the game thread builds a new snapshot
+* off to the side and swaps the pointer; readers take a reference to whatever is current and keep reading it for as
+* long as they like, never seeing a half written pose and never blocking evaluation.
+*
+* The lock only covers the pointer copy (one reference count increment), not the pose. Retired snapshots are kept
+* on a short list and reused for a later publish once every reader has released them, so steady state publishing
+* allocates nothing; snapshots still referenced past MaxRetired publishes are simply left to their readers and freed
+* with the last reference.
+**/
+class FSkeletalMeshPoseSnapshotSlot
+{
+public:
+	static constexpr int32 MaxRetired = 4;
+
+	//Current snapshot, null until the first publish. Any thread
+	FSkeletalMeshPoseSnapshotPtr Read() const
+	{
+		FReadScopeLock ReadLock(Lock);
+		return Current;
+	}
+
+	//Version of the latest publish without taking a reference, 0 before the first. Keeps counting across Reset. Any thread
+	uint64 GetVersion() const
+	{
+		return Version.load(std::memory_order_acquire);
+	}
+
+	/**
+	* Publish a new pose. Game thread, after the evaluation results have been swapped in (PostAnimEvaluation).
+	* The arrays are copied into a recycled snapshot whose capacity already fits in steady state.
+	**/
+	void Publish(TArrayView<const FTransform> InBoneSpaceTransforms, TArrayView<const FTransform> InComponentSpaceTransforms, const FTransform& InComponentToWorld, int32 InLODIndex)
+	{
+		TSharedPtr<FSkeletalMeshPoseSnapshot, ESPMode::ThreadSafe> Snapshot;
+		for (int32 Index = 0; Index < Retired.Num(); ++Index)
+		{
+			//Only the retired list holds it: no reader can observe the rewrite
+			if (Retired[Index].GetSharedReferenceCount() == 1)
+			{
+				Snapshot = MoveTemp(Retired[Index]);
+				Retired.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+				break;
+			}
+		}
+		if (!Snapshot.IsValid())
+		{
+			Snapshot = MakeShared<FSkeletalMeshPoseSnapshot, ESPMode::ThreadSafe>();
+		}
+
+		const uint64 NewVersion = Version.load(std::memory_order_relaxed) + 1;
+		Snapshot->BoneSpaceTransforms = InBoneSpaceTransforms;
+		Snapshot->ComponentSpaceTransforms = InComponentSpaceTransforms;
+		Snapshot->ComponentToWorld = InComponentToWorld;
+		Snapshot->Version = NewVersion;
+		Snapshot->FrameNumber = GFrameCounter;
+		Snapshot->LODIndex = InLODIndex;
+
+		TSharedPtr<FSkeletalMeshPoseSnapshot, ESPMode::ThreadSafe> Previous;
+		{
+			FWriteScopeLock WriteLock(Lock);
+			Previous = MoveTemp(CurrentMutable);
+			CurrentMutable = Snapshot;
+			Current = Snapshot;
+		}
+		Version.store(NewVersion, std::memory_order_release);
+
+		if (Previous.IsValid())
+		{
+			if (Retired.Num() == MaxRetired)
+			{
+				Retired.RemoveAtSwap(0, 1, EAllowShrinking::No);
+			}
+			Retired.Add(MoveTemp(Previous));
+		}
+	}
+
+	//Drop the current and retired snapshots (mesh change, unregister). Readers keep theirs
+	void Reset()
+	{
+		{
+			FWriteScopeLock WriteLock(Lock);
+			Current.Reset();
+			CurrentMutable.Reset();
+		}
+		Retired.Reset();
+	}
+
+private:
+	mutable FRWLock Lock;
+
+	//Published snapshot as handed to readers, and the same object as the game thread owns it for recycling
+	FSkeletalMeshPoseSnapshotPtr Current;
+	TSharedPtr<FSkeletalMeshPoseSnapshot, ESPMode::ThreadSafe> CurrentMutable;
+
+	//Game thread only
+	TArray<TSharedPtr<FSkeletalMeshPoseSnapshot, ESPMode::ThreadSafe>, TInlineAllocator<MaxRetired>> Retired;
+
+	std::atomic<uint64> Version{ 0 };
+};
@@ -0,0 +1,252 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Math/Float16.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_STATS_GROUP(TEXT("Skeletal Mesh Bone Upload"), STATGROUP_SkelMeshBoneUpload, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bone Upload Bytes"), STAT_SkelMeshBoneUploadBytes, STATGROUP_SkelMeshBoneUpload, ENGINE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Bone Upload Bytes (Full Precision Equivalent)"), STAT_SkelMeshBoneUploadBytesFull, STATGROUP_SkelMeshBoneUpload, ENGINE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Quantization Fallbacks"), STAT_SkelMeshBoneQuantizationFallbacks, STATGROUP_SkelMeshBoneUpload, ENGINE_API);
+
+/**
+* Per component, per frame decode parameters: translations are stored relative to the box that holds every bone
+* translation of the frame, so the 16 bit step shrinks with the character instead of being fixed in world units.
+**/
+struct FQuantizedBoneHeader
+{
+	FVector4f TranslationMin = FVector4f::Zero();
+
+	//Box size / 65535 per axis
+	FVector4f TranslationStep = FVector4f::Zero();
+};
+
+/**
+* 12 byte bone: rotation as smallest-three 10-10-10 (2 bit index of the dropped component, then three 10 bit values),
+* 16 bit translation per axis and half precision uniform scale. A full precision FMatrix3x4 is 48 bytes.
+**/
+struct FQuantizedBone12
+{
+	static constexpr int32 RotationBits = 10;
+
+	uint32 Rotation = 0;
+	uint16 Translation[3] = { 0, 0, 0 };
+	FFloat16 Scale;
+
+	uint64 GetRotation() const { return Rotation; }
+	void SetRotation(uint64 InPacked) { Rotation = static_cast<uint32>(InPacked); }
+};
+
+/** 16 byte bone: as FQuantizedBone12 with 15 bit rotation components, for hands and faces seen up close */
+struct FQuantizedBone16
+{
+	static constexpr int32 RotationBits = 15;
+
+	uint16 Rotation[3] = { 0, 0, 0 };
+	uint16 Translation[3] = { 0, 0, 0 };
+	FFloat16 Scale;
+	uint16 Padding = 0;
+
+	uint64 GetRotation() const { return uint64(Rotation[0]) | (uint64(Rotation[1]) << 16) | (uint64(Rotation[2]) << 32); }
+	void SetRotation(uint64 InPacked)
+	{
+		Rotation[0] = static_cast<uint16>(InPacked);
+		Rotation[1] = static_cast<uint16>(InPacked >> 16);
+		Rotation[2] = static_cast<uint16>(InPacked >> 32);
+	}
+};
+
+static_assert(sizeof(FQuantizedBone12) == 12, "Layout is mirrored by the skin cache / vertex factory decode");
+static_assert(sizeof(FQuantizedBone16) == 16, "Layout is mirrored by the skin cache / vertex factory decode");
+
+/**
+* Encoding of ref-to-local bone matrices for SendRenderDynamicData_Concurrent, and the CPU reference decoder the
+* shader decode (GPUSKIN_QUANTIZED_BONES) must match.
+*
+* Error bounds, with e = (1 / sqrt(2)) / (2^RotationBits - 1), half the rotation component step:
+*  - each stored rotation component is off by at most e; the rebuilt largest component (>= 1/2) by at most 3e, so the
+*    quaternion is off by at most sqrt(12) e and the rotation angle by at most 2 sqrt(12) e
+*    (4.8e-3 rad for 10 bits, 1.5e-4 rad for 15 bits)
+*  - translation is off by at most TranslationStep / 2 per axis
+*  - scale has the relative error of a half float, 2^-11
+**/
+namespace QuantizedBones
+{
+	template<int32 Bits>
+	constexpr float GetRotationComponentError()
+	{
+		return UE_INV_SQRT_2 / float((1u << Bits) - 1);
+	}
+
+	template<int32 Bits>
+	constexpr float GetMaxRotationErrorRadians()
+	{
+		return 2.f * 3.4641016f * GetRotationComponentError<Bits>();
+	}
+
+	//Smallest-three: drop the largest component (made positive), store the other three in [-1/sqrt(2), 1/sqrt(2)]
+	template<int32 Bits>
+	uint64 EncodeRotation(const FQuat4f& InRotation)
+	{
+		constexpr uint32 MaxValue = (1u << Bits) - 1;
+		const float Components[4] = { InRotation.X, InRotation.Y, InRotation.Z, InRotation.W };
+
+		int32 Largest = 0;
+		for (int32 Index = 1; Index < 4; ++Index)
+		{
+			if (FMath::Abs(Components[Index]) > FMath::Abs(Components[Largest]))
+			{
+				Largest = Index;
+			}
+		}
+		const float Sign = Components[Largest] < 0.f ? -1.f : 1.f;
+
+		uint64 Packed = static_cast<uint64>(Largest);
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			if (Index != Largest)
+			{
+				const float Normalized = Components[Index] * Sign * UE_SQRT_2 * 0.5f + 0.5f;
+				const uint32 Value = static_cast<uint32>(FMath::Clamp(Normalized * MaxValue + 0.5f, 0.f, float(MaxValue)));
+				Packed = (Packed << Bits) | Value;
+			}
+		}
+		return Packed;
+	}
+
+	template<int32 Bits>
+	FQuat4f DecodeRotation(uint64 InPacked)
+	{
+		constexpr uint32 MaxValue = (1u << Bits) - 1;
+		const int32 Largest = static_cast<int32>((InPacked >> (3 * Bits)) & 3);
+
+		float Components[4];
+		float SumSquares = 0.f;
+		for (int32 Index = 3; Index >= 0; --Index)
+		{
+			if (Index != Largest)
+			{
+				const float Normalized = float(InPacked & MaxValue) / float(MaxValue);
+				InPacked >>= Bits;
+				Components[Index] = (Normalized * 2.f - 1.f) * UE_INV_SQRT_2;
+				SumSquares += Components[Index] * Components[Index];
+			}
+		}
+		Components[Largest] = FMath::Sqrt(FMath::Max(0.f, 1.f - SumSquares));
+
+		FQuat4f Rotation(Components[0], Components[1], Components[2], Components[3]);
+		Rotation.Normalize();
+		return Rotation;
+	}
+
+	/**
+	* Quantize a frame's ref-to-local matrices.
+	* @return false if a bone has non-uniform scale, shear or a mirroring (negative determinant) basis; the caller then
+	* uploads full precision for this frame
+	**/
+	template<typename BoneType>
+	bool Pack(TArrayView<const FMatrix44f> InRefToLocals, FQuantizedBoneHeader& OutHeader, TArrayView<BoneType> OutBones)
+	{
+		check(OutBones.Num() >= InRefToLocals.Num());
+		if (InRefToLocals.Num() == 0)
+		{
+			return true;
+		}
+
+		//Translation bounds
+		VectorRegister4Float Min = VectorSetFloat1(UE_BIG_NUMBER);
+		VectorRegister4Float Max = VectorSetFloat1(-UE_BIG_NUMBER);
+		for (const FMatrix44f& Matrix : InRefToLocals)
+		{
+			const VectorRegister4Float Translation = VectorLoadAligned(&Matrix.M[3][0]);
+			Min = VectorMin(Min, Translation);
+			Max = VectorMax(Max, Translation);
+		}
+		const VectorRegister4Float Step = VectorMax(VectorMultiply(VectorSubtract(Max, Min), VectorSetFloat1(1.f / 65535.f)), VectorSetFloat1(UE_SMALL_NUMBER));
+		const VectorRegister4Float InvStep = VectorReciprocalAccurate(Step);
+		VectorStoreAligned(Min, &OutHeader.TranslationMin.X);
+		VectorStoreAligned(Step, &OutHeader.TranslationStep.X);
+
+		const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+		const VectorRegister4Float MaxQuantized = VectorSetFloat1(65535.f);
+		for (int32 Index = 0; Index < InRefToLocals.Num(); ++Index)
+		{
+			const FMatrix44f& Matrix = InRefToLocals[Index];
+			BoneType& Bone = OutBones[Index];
+
+			const VectorRegister4Float Row0 = VectorLoadAligned(&Matrix.M[0][0]);
+			const VectorRegister4Float Row1 = VectorLoadAligned(&Matrix.M[1][0]);
+			const VectorRegister4Float Row2 = VectorLoadAligned(&Matrix.M[2][0]);
+			const float ScaleSquared0 = VectorGetComponent(VectorDot3(Row0, Row0), 0);
+			const float ScaleSquared1 = VectorGetComponent(VectorDot3(Row1, Row1), 0);
+			const float ScaleSquared2 = VectorGetComponent(VectorDot3(Row2, Row2), 0);
+			const float Tolerance = 1e-3f * ScaleSquared0;
+			if (FMath::Abs(ScaleSquared1 - ScaleSquared0) > Tolerance || FMath::Abs(ScaleSquared2 - ScaleSquared0) > Tolerance
+				|| FMath::Abs(VectorGetComponent(VectorDot3(Row0, Row1), 0)) > Tolerance || FMath::Abs(VectorGetComponent(VectorDot3(Row0, Row2), 0)) > Tolerance
+				|| FMath::Abs(VectorGetComponent(VectorDot3(Row1, Row2), 0)) > Tolerance)
+			{
+				return false;
+			}
+
+			//A mirrored basis has no quaternion; RemoveScaling would leave a reflection that FQuat4f cannot represent
+			if (VectorGetComponent(VectorDot3(VectorCross(Row0, Row1), Row2), 0) <= 0.f)
+			{
+				return false;
+			}
+			const float Scale = FMath::Sqrt(ScaleSquared0);
+
+			FMatrix44f Rotation = Matrix;
+			Rotation.RemoveScaling();
+			Bone.SetRotation(EncodeRotation<BoneType::RotationBits>(FQuat4f(Rotation)));
+			Bone.Scale = FFloat16(Scale);
+
+			VectorRegister4Float Quantized = VectorMultiplyAdd(VectorSubtract(VectorLoadAligned(&Matrix.M[3][0]), Min), InvStep, Half);
+			Quantized = VectorMin(VectorMax(Quantized, VectorZeroFloat()), MaxQuantized);
+			alignas(16) float Values[4];
+			VectorStoreAligned(Quantized, Values);
+			Bone.Translation[0] = static_cast<uint16>(Values[0]);
+			Bone.Translation[1] = static_cast<uint16>(Values[1]);
+			Bone.Translation[2] = static_cast<uint16>(Values[2]);
+		}
+		return true;
+	}
+
+	/**
+	* Largest rotation angle error, in radians, of an encode/decode round trip over InNumSamples random rotations.
+	* Used to check the bounds documented above (GetMaxRotationErrorRadians) on the target platform's float math
+	**/
+	template<int32 Bits>
+	float MeasureMaxRotationErrorRadians(int32 InNumSamples, int32 InSeed = 0)
+	{
+		FRandomStream Random(InSeed);
+		float MaxError = 0.f;
+		for (int32 Sample = 0; Sample < InNumSamples; ++Sample)
+		{
+			FQuat4f Rotation(Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f), Random.FRandRange(-1.f, 1.f));
+			Rotation.Normalize();
+			const FQuat4f Decoded = DecodeRotation<Bits>(EncodeRotation<Bits>(Rotation));
+
+			//2 asin(|sin(angle / 2)|) of the difference, accurate for small angles unlike acos of the dot product
+			const FQuat4f Delta = Decoded * Rotation.Inverse();
+			const double HalfSine = FMath::Sqrt(double(Delta.X) * Delta.X + double(Delta.Y) * Delta.Y + double(Delta.Z) * Delta.Z);
+			MaxError = FMath::Max(MaxError, float(2.0 * FMath::Asin(FMath::Min(HalfSine, 1.0))));
+		}
+		return MaxError;
+	}
+
+	//CPU reference decoder, matching the shader decode
+	template<typename BoneType>
+	FMatrix44f Decode(const FQuantizedBoneHeader& InHeader, const BoneType& InBone)
+	{
+		const FQuat4f Rotation = DecodeRotation<BoneType::RotationBits>(InBone.GetRotation());
+		const FVector3f Translation(
+			InHeader.TranslationMin.X + InHeader.TranslationStep.X * InBone.Translation[0],
+			InHeader.TranslationMin.Y + InHeader.TranslationStep.Y * InBone.Translation[1],
+			InHeader.TranslationMin.Z + InHeader.TranslationStep.Z * InBone.Translation[2]);
+		const float Scale = InBone.Scale.GetFloat();
+		return FTransform3f(Rotation, Translation, FVector3f(Scale)).ToMatrixWithScale();
+	}
+}
@@ -0,0 +1,26 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "SkeletalMeshReplayCommandlet.generated.h"
+
+/**
+* Headless replay of a skeletal mesh frame recording (see FSkelMeshFrameReplayer), for comparing two builds on the
+* same workload:
+*   UnrealEditor-Cmd <Project> -run=SkeletalMeshReplay -Recording=<file> [-Iterations=N] [-Csv=<file>]
+* Creates a transient game world, replays the recording N times and prints p50/p90/p99 per stage; -Csv writes the
+* per-frame stage times.
+**/
+UCLASS()
+class USkeletalMeshReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
@@ -0,0 +1,183 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformTLS.h"
+#include <atomic>
+
+#ifndef WITH_SKELMESH_TASK_BREADCRUMBS
+#define WITH_SKELMESH_TASK_BREADCRUMBS 1
+#endif
+
+/** Worker tasks of the skeletal mesh pipeline that leave breadcrumbs */
+enum class ESkelMeshTaskBreadcrumb : uint8
+{
+	ParallelAnimationEvaluationTask,
+	ParallelClothTask,
+	ParallelBlendPhysicsCompletionTask,
+	Num
+};
+
+/** One begin or end record, written by its owning thread only. 32 bytes where FName is 8 bytes (no case preserving names) */
+struct FSkelMeshTaskBreadcrumbEntry
+{
+	uint64 Cycles = 0;
+
+	//Name of the skeletal mesh asset; resolved to a string only when the ring is flushed
+	FName Mesh;
+
+	//UObject unique id of the component
+	uint32 ComponentId = 0;
+
+	//Low 32 bits of GFrameCounter
+	uint32 Frame = 0;
+
+	//Low 32 bits of the record number + 1 once the record is complete, 0 while it is being written
+	std::atomic<uint32> Sequence{ 0 };
+
+	ESkelMeshTaskBreadcrumb Task = ESkelMeshTaskBreadcrumb::Num;
+	uint8 bBegin : 1;
+};
+
+#if !WITH_CASE_PRESERVING_NAME
+static_assert(sizeof(FSkelMeshTaskBreadcrumbEntry) == 32, "FSkelMeshTaskBreadcrumbEntry should pack into 32 bytes, two per cache line");
+#endif
+
+/**
+* Always-on, per-thread ring of the last Capacity task begin/end records, flushed into the crash folder as
+* Breadcrumbs_SkelMeshTasks_<ThreadId>.txt next to the RHI breadcrumbs.
+*
+* Each thread writes only its own ring, with no locks and no shared cache lines: a record clears the entry's Sequence,
+* stores the fields, then release-stores Sequence and Head. Rings are linked into a global list the first time a
+* thread records and are never freed, so the crash handler can walk them at any time. The crash handler reads without
+* stopping writers, seqlock style: an entry is only trusted if its Sequence matches the record number it should hold
+* both before and after its fields are copied. Any other entry (being written, or overwritten by a newer lap while it
+* was read) is written as a Torn line, which tools/breadcrumb_timeline counts and skips.
+**/
+class FSkelMeshTaskBreadcrumbs
+{
+public:
+	static constexpr uint32 Capacity = 256;
+
+	//Cache line aligned so no thread's ring shares a line with another ring or allocation
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FRing
+	{
+		FSkelMeshTaskBreadcrumbEntry Entries[Capacity];
+
+		//Number of records ever written; the next record goes to Entries[Head % Capacity]
+		std::atomic<uint64> Head{ 0 };
+
+		uint32 ThreadId = 0;
+		FRing* Next = nullptr;
+	};
+
+	static FORCEINLINE void Record(ESkelMeshTaskBreadcrumb InTask, bool bInBegin, uint32 InComponentId, FName InMesh)
+	{
+#if WITH_SKELMESH_TASK_BREADCRUMBS
+		FRing& Ring = GetThreadRing();
+		const uint64 Head = Ring.Head.load(std::memory_order_relaxed);
+		FSkelMeshTaskBreadcrumbEntry& Entry = Ring.Entries[Head & (Capacity - 1)];
+		Entry.Sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		Entry.Cycles = FPlatformTime::Cycles64();
+		Entry.Mesh = InMesh;
+		Entry.ComponentId = InComponentId;
+		Entry.Frame = static_cast<uint32>(GFrameCounter);
+		Entry.Task = InTask;
+		Entry.bBegin = bInBegin;
+		Entry.Sequence.store(static_cast<uint32>(Head + 1), std::memory_order_release);
+		Ring.Head.store(Head + 1, std::memory_order_release);
+#endif
+	}
+
+	/**
+	* Write every ring as text into the crash folder. Registered with FGenericCrashContext::OnAdditionalCrashContextDelegate
+	* at module startup; may also be called for ensures and stall reports.
+	**/
+	static ENGINE_API void WriteToCrashContext(class FCrashContextExtendedWriter& InWriter);
+
+	/**
+	* Text form of one ring, oldest record first, as written to the crash folder and read by tools/breadcrumb_timeline:
+	*   Breadcrumbs 'SkelMeshTasks' Thread <ThreadId>
+	*   CyclesPerSecond <1 / FPlatformTime::GetSecondsPerCycle64()>
+	*   <Frame> <Cycles> <B|E> <Task> <ComponentId> <Mesh>
+	*   Torn <RecordNumber>        (entry whose Sequence did not validate, see above)
+	**/
+	static ENGINE_API FString FormatRing(const FRing& InRing);
+
+	/**
+	* Copy the entry that should hold record InRecord (0 based), seqlock style.
+	* @return false if the entry is being written or holds another record
+	**/
+	static bool ReadEntry(const FRing& InRing, uint64 InRecord, FSkelMeshTaskBreadcrumbEntry& OutEntry)
+	{
+		const FSkelMeshTaskBreadcrumbEntry& Entry = InRing.Entries[InRecord & (Capacity - 1)];
+		const uint32 Expected = static_cast<uint32>(InRecord + 1);
+		if (Entry.Sequence.load(std::memory_order_acquire) != Expected)
+		{
+			return false;
+		}
+		OutEntry.Cycles = Entry.Cycles;
+		OutEntry.Mesh = Entry.Mesh;
+		OutEntry.ComponentId = Entry.ComponentId;
+		OutEntry.Frame = Entry.Frame;
+		OutEntry.Task = Entry.Task;
+		OutEntry.bBegin = Entry.bBegin;
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return Entry.Sequence.load(std::memory_order_relaxed) == Expected;
+	}
+
+	//Head of the list of all rings, newest thread first
+	static FRing* GetFirstRing() { return FirstRing.load(std::memory_order_acquire); }
+
+private:
+	static FORCEINLINE FRing& GetThreadRing()
+	{
+		static thread_local FRing* ThreadRing = nullptr;
+		if (UNLIKELY(!ThreadRing))
+		{
+			ThreadRing = RegisterThreadRing();
+		}
+		return *ThreadRing;
+	}
+
+	//Allocate the calling thread's ring and push it onto the global list
+	static FRing* RegisterThreadRing()
+	{
+		FRing* Ring = new FRing();
+		Ring->ThreadId = FPlatformTLS::GetCurrentThreadId();
+		FRing* Expected = FirstRing.load(std::memory_order_relaxed);
+		do
+		{
+			Ring->Next = Expected;
+		} while (!FirstRing.compare_exchange_weak(Expected, Ring, std::memory_order_release, std::memory_order_relaxed));
+		return Ring;
+	}
+
+	static ENGINE_API std::atomic<FRing*> FirstRing;
+};
+
+/** Records begin on construction and end on destruction, for the DoTask bodies of the skeletal mesh tasks */
+struct FScopedSkelMeshTaskBreadcrumb
+{
+	FScopedSkelMeshTaskBreadcrumb(ESkelMeshTaskBreadcrumb InTask, uint32 InComponentId, FName InMesh)
+		: Mesh(InMesh), ComponentId(InComponentId), Task(InTask)
+	{
+		FSkelMeshTaskBreadcrumbs::Record(Task, true, ComponentId, Mesh);
+	}
+
+	~FScopedSkelMeshTaskBreadcrumb()
+	{
+		FSkelMeshTaskBreadcrumbs::Record(Task, false, ComponentId, Mesh);
+	}
+
+	FScopedSkelMeshTaskBreadcrumb(const FScopedSkelMeshTaskBreadcrumb&) = delete;
+	FScopedSkelMeshTaskBreadcrumb& operator=(const FScopedSkelMeshTaskBreadcrumb&) = delete;
+
+private:
+	FName Mesh;
+	uint32 ComponentId;
+	ESkelMeshTaskBreadcrumb Task;
+};
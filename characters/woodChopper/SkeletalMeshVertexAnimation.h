@@ -0,0 +1,137 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Commandlets/Commandlet.h"
+#include "SkeletalMeshVertexAnimationPlayback.h"
+
+#include "SkeletalMeshVertexAnimation.generated.h"
+
+class UAnimSequence;
+class UMaterialInterface;
+class USkeletalMesh;
+class UStaticMesh;
+class UTexture2D;
+
+/** What the animation texture stores */
+UENUM()
+enum class EVertexAnimationBakeMode : uint8
+{
+	//One 3x4 matrix per bone per frame; the proxy mesh keeps bone indices and weights and skins in the vertex shader
+	Bones,
+	//One position offset (and normal) per vertex per frame; cheapest to play back, large for dense meshes
+	Vertices
+};
+
+/** One baked sequence */
+USTRUCT()
+struct FVertexAnimationClip
+{
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	TSoftObjectPtr<UAnimSequence> Sequence;
+
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	int32 FirstFrame = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	int32 NumFrames = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	float FrameRate = 30.f;
+
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	bool bLooping = true;
+
+	FVertexAnimationClipRange GetRange() const { return { FirstFrame, NumFrames, FrameRate, bLooping }; }
+};
+
+/**
+* Baked texture playback data for one skeletal mesh LOD: the animation texture, the proxy static mesh that samples it
+* and the clip table. Produced by USkeletalMeshVertexAnimationBakeCommandlet and referenced by
+* USkeletalMeshComponent::VertexAnimation.
+**/
+UCLASS(MinimalAPI)
+class USkeletalMeshVertexAnimation : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	TSoftObjectPtr<USkeletalMesh> SourceMesh;
+
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	int32 SourceLOD = 0;
+
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	EVertexAnimationBakeMode Mode = EVertexAnimationBakeMode::Bones;
+
+	//RGBA16F, layout per FVertexAnimationTextureLayout
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	TObjectPtr<UTexture2D> AnimationTexture;
+
+	//FVertexAnimationTextureLayout::RowsPerFrame of AnimationTexture, passed to Material with the texture width
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	int32 RowsPerFrame = 1;
+
+	//SourceLOD converted to a static mesh: vertex index in UV1, and for Bones mode bone indices/weights in UV2-UV3
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	TObjectPtr<UStaticMesh> ProxyMesh;
+
+	//Material instance sampling AnimationTexture with the frames/alpha passed as per-instance custom data
+	UPROPERTY(EditAnywhere, Category = VertexAnimation)
+	TObjectPtr<UMaterialInterface> Material;
+
+	UPROPERTY(VisibleAnywhere, Category = VertexAnimation)
+	TArray<FVertexAnimationClip> Clips;
+
+	//Clip baked from InSequence, INDEX_NONE if it was not baked. Compares paths, so clips whose soft pointer is not resolved yet still match
+	int32 FindClip(const UAnimSequence* InSequence) const
+	{
+		const FSoftObjectPath SequencePath(InSequence);
+		return Clips.IndexOfByPredicate([&SequencePath](const FVertexAnimationClip& Clip) { return Clip.Sequence.ToSoftObjectPath() == SequencePath; });
+	}
+};
+
+/**
+* Bakes a skeletal mesh LOD and a set of sequences into a USkeletalMeshVertexAnimation. Evaluates the sequences with
+* UAnimSequence::GetAnimationPose and the reference skeleton only, so no world, viewport or GPU is needed.
+**/
+struct FVertexAnimationBaker
+{
+	struct FSettings
+	{
+		EVertexAnimationBakeMode Mode = EVertexAnimationBakeMode::Bones;
+		int32 LODIndex = 0;
+		float FrameRate = 30.f;
+	};
+
+	/**
+	* @param InMesh: Source mesh
+	* @param InSequences: Sequences to bake, one clip each, in texture row order
+	* @param OutAsset: Asset receiving the texture, proxy mesh and clip table
+	* @param OutError: Reason on failure (mesh/skeleton mismatch, texture taller than FVertexAnimationTextureLayout::MaxWidth...)
+	**/
+	static ENGINE_API bool Bake(USkeletalMesh* InMesh, TArrayView<UAnimSequence* const> InSequences, const FSettings& InSettings, USkeletalMeshVertexAnimation* OutAsset, FString& OutError);
+};
+
+/**
+* Headless bake, Linux included:
+*   UnrealEditor-Cmd <Project> -run=SkeletalMeshVertexAnimationBake -nullrhi -Mesh=<path> -Sequences=<path>[+<path>...]
+*     -Output=<package path> [-LOD=N] [-Mode=Bones|Vertices] [-FrameRate=30]
+* e.g. -Mesh=/Game/CasualSet01/customMovement/woodChopping/woodChooper_skin -LOD=2
+*      -Sequences=/Game/CasualSet01/customMovement/woodChopping/animSkel/chop_Mannequin
+**/
+UCLASS()
+class USkeletalMeshVertexAnimationBakeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
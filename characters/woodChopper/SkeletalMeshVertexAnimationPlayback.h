@@ -0,0 +1,206 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+* CPU side of texture-driven (vertex / bone animation texture) playback for distant characters.
+* Nothing in this file touches UObjects or the renderer, so the timing and switching rules can be exercised on their own.
+**/
+
+/** Where a baked sequence lives in the animation texture */
+struct FVertexAnimationClipRange
+{
+	//First texture row (frame) of the clip
+	int32 FirstFrame = 0;
+	int32 NumFrames = 0;
+
+	//Frames per second the clip was baked at
+	float FrameRate = 30.f;
+
+	bool bLooping = true;
+
+	float GetLength() const { return NumFrames > 1 ? float(NumFrames - 1) / FrameRate : 0.f; }
+};
+
+/** Two texture rows and the blend between them, as the material samples them */
+struct FVertexAnimationSample
+{
+	int32 FrameA = 0;
+	int32 FrameB = 0;
+	float Alpha = 0.f;
+};
+
+namespace VertexAnimation
+{
+	//Wrap or clamp a playback time into the clip
+	inline float WrapTime(const FVertexAnimationClipRange& InClip, float InTime)
+	{
+		const float Length = InClip.GetLength();
+		if (Length <= 0.f)
+		{
+			return 0.f;
+		}
+		if (InClip.bLooping)
+		{
+			const float Wrapped = FMath::Fmod(InTime, Length);
+			return Wrapped < 0.f ? Wrapped + Length : Wrapped;
+		}
+		return FMath::Clamp(InTime, 0.f, Length);
+	}
+
+	//Texture rows to sample at InTime; the last frame of a looping clip blends back into the first
+	inline FVertexAnimationSample Sample(const FVertexAnimationClipRange& InClip, float InTime)
+	{
+		FVertexAnimationSample Result;
+		if (InClip.NumFrames <= 0)
+		{
+			return Result;
+		}
+
+		const float Frame = WrapTime(InClip, InTime) * InClip.FrameRate;
+		const int32 Whole = FMath::Min(FMath::FloorToInt32(Frame), InClip.NumFrames - 1);
+		Result.Alpha = FMath::Clamp(Frame - float(Whole), 0.f, 1.f);
+		Result.FrameA = InClip.FirstFrame + Whole;
+		Result.FrameB = InClip.FirstFrame + (Whole + 1 < InClip.NumFrames ? Whole + 1 : (InClip.bLooping ? 0 : Whole));
+		return Result;
+	}
+}
+
+/** Which path drives the character this frame */
+enum class EVertexAnimationMode : uint8
+{
+	//Normal skeletal evaluation and skinning
+	Skeletal,
+	//Skeletal evaluation has been restarted at the texture's time but the texture is still displayed; shown next frame
+	WarmingSkeletal,
+	//Texture playback only: no animation evaluation, no RefreshBoneTransforms, no skinning
+	Texture
+};
+
+/**
+* Distance based switch between skeletal and texture playback with hysteresis, and the time hand-over that makes the
+* switch invisible. Going out, the texture starts at the skeletal sequence's current position. Coming back, the
+* skeletal sequence is seeded one delta behind the texture (SkeletalSeedTime) before TickPose, so the warm frame's
+* tick lands on the texture's time, and it is evaluated for that frame (WarmingSkeletal) while the texture is still on
+* screen. The first visible skeletal frame then has a valid pose at exactly the texture's phase.
+**/
+struct FVertexAnimationPlaybackState
+{
+	EVertexAnimationMode Mode = EVertexAnimationMode::Skeletal;
+
+	//Texture playback time within the current clip
+	float Time = 0.f;
+	float PlayRate = 1.f;
+	int32 ClipIndex = 0;
+
+	//Position to give the skeletal sequence, before TickPose, on the frame Update enters WarmingSkeletal
+	float SkeletalSeedTime = 0.f;
+
+	/**
+	* Advance one frame.
+	* @param InDistance: Distance from the closest view to the character
+	* @param InSwitchDistance: Distance below which skeletal playback comes back (Texture -> WarmingSkeletal)
+	* @param InHysteresis: Extra distance past InSwitchDistance before switching out to texture playback
+	* (Skeletal -> Texture above InSwitchDistance + InHysteresis), so the switch does not flicker on the boundary
+	* @param InSkeletalTime: Current position of the skeletal sequence, used when switching to texture playback
+	* @param InClip: Clip being played
+	* @return true if the mode changed; when it becomes WarmingSkeletal the caller sets the sequence position to
+	* SkeletalSeedTime before this frame's TickPose
+	**/
+	bool Update(float InDeltaTime, float InDistance, float InSwitchDistance, float InHysteresis, float InSkeletalTime, const FVertexAnimationClipRange& InClip)
+	{
+		const EVertexAnimationMode OldMode = Mode;
+		switch (Mode)
+		{
+		case EVertexAnimationMode::Skeletal:
+			if (InDistance > InSwitchDistance + InHysteresis)
+			{
+				Mode = EVertexAnimationMode::Texture;
+				Time = VertexAnimation::WrapTime(InClip, InSkeletalTime);
+			}
+			break;
+
+		case EVertexAnimationMode::Texture:
+			Time = VertexAnimation::WrapTime(InClip, Time + InDeltaTime * PlayRate);
+			if (InDistance < InSwitchDistance)
+			{
+				//This frame's TickPose advances the sequence by the same delta the texture just took
+				Mode = EVertexAnimationMode::WarmingSkeletal;
+				SkeletalSeedTime = VertexAnimation::WrapTime(InClip, Time - InDeltaTime * PlayRate);
+			}
+			break;
+
+		case EVertexAnimationMode::WarmingSkeletal:
+			//The warm frame's skeletal pose was at last frame's Time; TickPose now advances it by the same delta as Time
+			Mode = InDistance > InSwitchDistance + InHysteresis ? EVertexAnimationMode::Texture : EVertexAnimationMode::Skeletal;
+			Time = VertexAnimation::WrapTime(InClip, Time + InDeltaTime * PlayRate);
+			break;
+		}
+		return Mode != OldMode;
+	}
+
+	//Whether the skeletal mesh needs animation evaluation this frame
+	bool NeedsSkeletalEvaluation() const { return Mode != EVertexAnimationMode::Texture; }
+
+	//Whether the animation texture is what gets rendered this frame
+	bool IsTextureVisible() const { return Mode != EVertexAnimationMode::Skeletal; }
+};
+
+/**
+* Texture layout of an animation texture. A bone animation texture stores three texels per bone per frame (the rows
+* of its ref-to-local 3x4 matrix in RGBA16F); a vertex animation texture stores two texels per vertex per frame, the
+* position offset followed by the normal. A frame's texels are laid out row-major and wrap onto extra rows when they
+* do not fit in MaxWidth, so every frame spans RowsPerFrame rows. The material needs Width and RowsPerFrame to
+* address a texel.
+**/
+struct FVertexAnimationTextureLayout
+{
+	//Largest texture dimension supported by every RHI we ship on
+	static constexpr int32 MaxWidth = 16384;
+
+	int32 Width = 0;
+	int32 Height = 0;
+	int32 RowsPerFrame = 0;
+
+	static FVertexAnimationTextureLayout ForTexels(int32 InTexelsPerFrame, int32 InTotalFrames)
+	{
+		FVertexAnimationTextureLayout Layout;
+		Layout.Width = FMath::Min(InTexelsPerFrame, MaxWidth);
+		Layout.RowsPerFrame = Layout.Width > 0 ? FMath::DivideAndRoundUp(InTexelsPerFrame, Layout.Width) : 0;
+		Layout.Height = Layout.RowsPerFrame * InTotalFrames;
+		return Layout;
+	}
+
+	static FVertexAnimationTextureLayout ForBones(int32 InNumBones, int32 InTotalFrames)
+	{
+		return ForTexels(InNumBones * 3, InTotalFrames);
+	}
+
+	static FVertexAnimationTextureLayout ForVertices(int32 InNumVertices, int32 InTotalFrames)
+	{
+		return ForTexels(InNumVertices * 2, InTotalFrames);
+	}
+
+	//Whether the texture fits in MaxWidth x MaxWidth; FVertexAnimationBaker::Bake fails otherwise
+	bool IsValid() const { return Width > 0 && Height > 0 && Height <= MaxWidth; }
+
+	//Texel of a bone matrix row in a bone animation texture
+	FIntPoint GetBoneTexel(int32 InBoneIndex, int32 InRow, int32 InFrame) const
+	{
+		return GetTexel(InBoneIndex * 3 + InRow, InFrame);
+	}
+
+	//Texel of a vertex position offset (or of its normal) in a vertex animation texture
+	FIntPoint GetVertexTexel(int32 InVertexIndex, bool bNormal, int32 InFrame) const
+	{
+		return GetTexel(InVertexIndex * 2 + (bNormal ? 1 : 0), InFrame);
+	}
+
+private:
+	FIntPoint GetTexel(int32 InTexelInFrame, int32 InFrame) const
+	{
+		return FIntPoint(InTexelInFrame % Width, InFrame * RowsPerFrame + InTexelInFrame / Width);
+	}
+};
@@ -0,0 +1,91 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/World.h"
+#include "SkeletalMeshAggregateManager.h"
+#include "RootMotionBatch.h"
+#include "AnimNotifyBatchDispatcher.h"
+#include "SkeletalMeshBatchedTick.h"
+
+#include "SkeletalMeshWorldSubsystem.generated.h"
+
+/**
+* Owner of the per-world skeletal mesh managers. Each manager is created on first use through its static Get and
+* destroyed in Deinitialize, when the world is cleaned up, so nothing outlives the world or its physics scene.
+* After Deinitialize the getters return nullptr instead of recreating a manager, so callers reaching the subsystem
+* during teardown (EndPlay, OnUnregister of components destroyed with the world) must handle a null manager.
+**/
+UCLASS(MinimalAPI)
+class USkeletalMeshWorldSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static USkeletalMeshWorldSubsystem* Get(const UWorld* InWorld)
+	{
+		return InWorld ? InWorld->GetSubsystem<USkeletalMeshWorldSubsystem>() : nullptr;
+	}
+
+	FSkeletalMeshAggregateManager* GetAggregateManager()
+	{
+		if (!AggregateManager.IsValid() && !bDeinitialized && GetWorld()->GetPhysicsScene())
+		{
+			AggregateManager = MakeUnique<FSkeletalMeshAggregateManager>(GetWorld()->GetPhysicsScene());
+		}
+		return AggregateManager.Get();
+	}
+
+	FRootMotionBatch* GetRootMotionBatch()
+	{
+		if (!RootMotionBatch.IsValid() && !bDeinitialized)
+		{
+			RootMotionBatch = MakeUnique<FRootMotionBatch>();
+		}
+		return RootMotionBatch.Get();
+	}
+
+	FAnimNotifyBatchDispatcher* GetAnimNotifyDispatcher()
+	{
+		if (!AnimNotifyDispatcher.IsValid() && !bDeinitialized)
+		{
+			AnimNotifyDispatcher = MakeUnique<FAnimNotifyBatchDispatcher>();
+		}
+		return AnimNotifyDispatcher.Get();
+	}
+
+	FSkeletalMeshBatchedTickManager* GetBatchedTickManager()
+	{
+		if (!BatchedTickManager.IsValid() && !bDeinitialized)
+		{
+			BatchedTickManager = MakeUnique<FSkeletalMeshBatchedTickManager>(GetWorld());
+		}
+		return BatchedTickManager.Get();
+	}
+
+	//~ Begin USubsystem Interface
+	virtual void Deinitialize() override
+	{
+		//Set first so nothing destroyed below can recreate a manager through the getters
+		bDeinitialized = true;
+
+		//Releases every shared aggregate while the physics scene still exists
+		AggregateManager.Reset();
+		RootMotionBatch.Reset();
+		AnimNotifyDispatcher.Reset();
+		BatchedTickManager.Reset();
+		Super::Deinitialize();
+	}
+	//~ End USubsystem Interface
+
+private:
+	TUniquePtr<FSkeletalMeshAggregateManager> AggregateManager;
+	TUniquePtr<FRootMotionBatch> RootMotionBatch;
+	TUniquePtr<FAnimNotifyBatchDispatcher> AnimNotifyDispatcher;
+	TUniquePtr<FSkeletalMeshBatchedTickManager> BatchedTickManager;
+
+	//Set in Deinitialize; the getters stop creating managers from then on
+	bool bDeinitialized = false;
+};
@@ -0,0 +1,106 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "Tasks/Task.h"
+#include "Hash/CityHash.h"
+
+class UPhysicsAsset;
+class USkeletalMesh;
+struct FNavigableGeometryExport;
+
+/**
+* Navigable collision of a skeletal character, triangulated from the physics asset in component space.
+* Immutable once built and shared between all components that map to the same FSkeletalNavGeometryKey.
+**/
+struct FSkeletalNavGeometry
+{
+	TArray<FVector3f> Vertices;
+	TArray<int32> Indices;
+
+	//Write this geometry into a navmesh export at the component's current transform
+	ENGINE_API void Export(FNavigableGeometryExport& GeomExport, const FTransform& InLocalToWorld) const;
+};
+
+/**
+* Cache key: the physics asset and mesh, the component scale and the pose the bodies were taken from.
+* PoseHash is 0 for the reference pose; components with a frozen pose (e.g. an idle NPC that no longer animates)
+* pass HashPose of their component space transforms. The hash is 64 bits wide because a collision would silently
+* serve another pose's geometry: with a few thousand frozen poses alive the odds are around 1e-13, where 32 bits
+* already reach 1e-3.
+**/
+struct FSkeletalNavGeometryKey
+{
+	TObjectKey<UPhysicsAsset> PhysicsAsset;
+	TObjectKey<USkeletalMesh> SkeletalMesh;
+
+	//Scale quantized to 1/1000 so float noise does not split entries
+	FIntVector QuantizedScale = FIntVector::ZeroValue;
+
+	uint64 PoseHash = 0;
+
+	//Never returns 0, which is reserved for the reference pose
+	static uint64 HashPose(TArrayView<const FTransform> InComponentSpaceTransforms)
+	{
+		const uint64 Hash = CityHash64(reinterpret_cast<const char*>(InComponentSpaceTransforms.GetData()), InComponentSpaceTransforms.Num() * sizeof(FTransform));
+		return Hash != 0 ? Hash : 1;
+	}
+
+	bool IsFrozenPose() const { return PoseHash != 0; }
+
+	static FIntVector QuantizeScale(const FVector& InScale)
+	{
+		return FIntVector(FMath::RoundToInt32(InScale.X * 1000.0), FMath::RoundToInt32(InScale.Y * 1000.0), FMath::RoundToInt32(InScale.Z * 1000.0));
+	}
+
+	bool operator==(const FSkeletalNavGeometryKey& Other) const
+	{
+		return PhysicsAsset == Other.PhysicsAsset && SkeletalMesh == Other.SkeletalMesh && QuantizedScale == Other.QuantizedScale && PoseHash == Other.PoseHash;
+	}
+
+	friend uint32 GetTypeHash(const FSkeletalNavGeometryKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.PhysicsAsset), GetTypeHash(Key.SkeletalMesh));
+		Hash = HashCombine(Hash, GetTypeHash(Key.QuantizedScale));
+		return HashCombine(Hash, GetTypeHash(Key.PoseHash));
+	}
+};
+
+/**
+* Process-wide cache of FSkeletalNavGeometry used by USkeletalMeshComponent::DoCustomNavigableGeometryExport.
+* Reference pose entries are only invalidated when their physics asset or mesh changes (Invalidate) or is destroyed;
+* a change of component scale simply maps to another key.
+* Frozen pose entries are unique to one or a few components, so they are reference counted instead: a component
+* retains its key when it exports a frozen pose and releases it when its pose key changes or it unregisters, and the
+* entry is evicted with its last reference. Callers building a frozen pose key through FindOrBuild or BuildAsync
+* must hold a reference on it first, or the entry has no owner and is never evicted.
+**/
+class FSkeletalNavGeometryCache
+{
+public:
+	//Return the cached geometry for a key, or nullptr if it has not been built yet
+	static ENGINE_API TSharedPtr<const FSkeletalNavGeometry> Find(const FSkeletalNavGeometryKey& InKey);
+
+	//Return the cached geometry for a key, building it synchronously with InBuild on a miss
+	static ENGINE_API TSharedPtr<const FSkeletalNavGeometry> FindOrBuild(const FSkeletalNavGeometryKey& InKey, TFunctionRef<void(FSkeletalNavGeometry&)> InBuild);
+
+	/**
+	* Build the geometry for a key on a worker if it is not cached yet. Concurrent requests for the same key share one task.
+	* InBuild must only read data captured by value (body setups and bone transforms), never the component.
+	**/
+	static ENGINE_API UE::Tasks::TTask<TSharedPtr<const FSkeletalNavGeometry>> BuildAsync(const FSkeletalNavGeometryKey& InKey, TUniqueFunction<void(FSkeletalNavGeometry&)>&& InBuild);
+
+	//Retain a frozen pose entry (InKey.IsFrozenPose()). A no-op for reference pose keys
+	static ENGINE_API void AddPoseReference(const FSkeletalNavGeometryKey& InKey);
+
+	//Release a reference taken with AddPoseReference, evicting the entry with its last reference
+	static ENGINE_API void ReleasePoseReference(const FSkeletalNavGeometryKey& InKey);
+
+	//Drop every entry built from InAsset (either a physics asset or a skeletal mesh)
+	static ENGINE_API void Invalidate(const UObject* InAsset);
+
+	//Number of cached entries and total bytes held, for memreport
+	static ENGINE_API void GetStats(int32& OutNumEntries, SIZE_T& OutNumBytes);
+};
@@ -0,0 +1,266 @@
+//Part of openWorldProject. Extends the Epic Games USkeletalMeshComponent (see SkeletalMeshComponent.h)
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/ParallelFor.h"
+#include <algorithm>
+
+/**
+* Triangle bounding volume hierarchy over one skeletal mesh LOD, used for per-poly collision (bEnablePerPolyCollision).
+*
+* The topology is built once in the reference pose and never rebuilt: when the pose changes only the node bounds are
+* refit, and only on frames where a query actually arrives. Two refit modes exist:
+*  - Refit: bounds recomputed from fully skinned positions, deepest level first, each level in parallel.
+*  - RefitConservative: leaf bounds are the union of the leaf's reference box transformed by each bone that influences
+*    it (a handful of bones per leaf, no vertex skinning). Traversal then skins only the vertices of leaves it visits.
+*    Morph targets are covered by inflating each leaf's reference box by its largest morph delta (SetMorphExtents)
+*    scaled by the active weights. Cloth is not bounded by the bones at all, so callers use Refit while it simulates.
+**/
+struct FSkeletalTriangleBVH
+{
+	struct FNode
+	{
+		FBox3f Bounds;
+
+		//Leaf: first entry in Triangles. Inner node: index of the first child (the second follows it)
+		int32 First = 0;
+
+		//Number of triangles for a leaf, 0 for an inner node
+		int32 NumTriangles = 0;
+
+		bool IsLeaf() const { return NumTriangles > 0; }
+	};
+
+	TArray<FNode> Nodes;
+
+	//Triangle indices (into the LOD index buffer / 3) in leaf order
+	TArray<int32> Triangles;
+
+	//Copy of the LOD index buffer
+	TArray<uint32> Indices;
+
+	//Start of each depth level in LevelNodes, plus a final entry; refit walks levels deepest first
+	TArray<int32> LevelNodes;
+	TArray<int32> LevelStarts;
+
+	//Per leaf (indexed like Nodes): bones influencing the leaf's vertices and the leaf's reference pose box, for RefitConservative
+	TArray<TArray<FBoneIndexType, TInlineAllocator<4>>> LeafBones;
+	TArray<FBox3f> LeafRefBounds;
+
+	//Per leaf (indexed like Nodes): largest morph target delta length over the leaf's vertices and all morph targets, 0 without morphs
+	TArray<float> LeafMorphExtents;
+
+	int32 MaxLeafTriangles = 8;
+
+	//An LOD without triangles has no nodes; Refit, RefitConservative and the raycasts do nothing
+	bool IsEmpty() const { return Nodes.Num() == 0; }
+
+	/**
+	* Build the hierarchy from reference pose positions with median splits along the longest axis
+	* @param InRefPositions: Reference pose vertex positions of the LOD
+	* @param InIndices: LOD index buffer (three indices per triangle)
+	* @param InInfluenceBones: Mesh bone index of each influence, InMaxInfluences per vertex (skin weight buffer order)
+	* @param InInfluenceWeights: Weight of each influence, 0 for unused slots
+	* @param InMaxInfluences: Influences per vertex in the two arrays above
+	**/
+	void Build(TArrayView<const FVector3f> InRefPositions, TArrayView<const uint32> InIndices, TArrayView<const FBoneIndexType> InInfluenceBones, TArrayView<const uint16> InInfluenceWeights, int32 InMaxInfluences)
+	{
+		check(InInfluenceBones.Num() == InRefPositions.Num() * InMaxInfluences && InInfluenceWeights.Num() == InInfluenceBones.Num());
+		Indices = InIndices;
+		const int32 NumTriangles = Indices.Num() / 3;
+
+		Nodes.Reset();
+		LevelNodes.Reset();
+		LevelStarts.Reset();
+		LeafBones.Reset();
+		LeafRefBounds.Reset();
+		LeafMorphExtents.Reset();
+		if (NumTriangles == 0)
+		{
+			Triangles.Reset();
+			return;
+		}
+
+		TArray<FVector3f> Centroids;
+		Centroids.SetNumUninitialized(NumTriangles);
+		Triangles.SetNumUninitialized(NumTriangles);
+		for (int32 Triangle = 0; Triangle < NumTriangles; ++Triangle)
+		{
+			Triangles[Triangle] = Triangle;
+			Centroids[Triangle] = (InRefPositions[Indices[Triangle * 3]] + InRefPositions[Indices[Triangle * 3 + 1]] + InRefPositions[Indices[Triangle * 3 + 2]]) / 3.f;
+		}
+
+		Nodes.AddDefaulted();
+		struct FPending { int32 Node; int32 Begin; int32 End; int32 Depth; };
+		TArray<FPending> Stack;
+		Stack.Add({ 0, 0, NumTriangles, 0 });
+		TArray<int32> NodeDepth;
+		NodeDepth.Add(0);
+
+		while (Stack.Num() > 0)
+		{
+			const FPending Pending = Stack.Pop(EAllowShrinking::No);
+
+			FBox3f CentroidBounds(ForceInit);
+			for (int32 It = Pending.Begin; It < Pending.End; ++It)
+			{
+				CentroidBounds += Centroids[Triangles[It]];
+			}
+
+			const int32 Count = Pending.End - Pending.Begin;
+			if (Count <= MaxLeafTriangles)
+			{
+				Nodes[Pending.Node].First = Pending.Begin;
+				Nodes[Pending.Node].NumTriangles = Count;
+				continue;
+			}
+
+			const FVector3f Size = CentroidBounds.GetSize();
+			const int32 Axis = (Size.X >= Size.Y && Size.X >= Size.Z) ? 0 : (Size.Y >= Size.Z ? 1 : 2);
+			const int32 Mid = Pending.Begin + Count / 2;
+			int32* TrianglesBegin = Triangles.GetData() + Pending.Begin;
+			std::nth_element(TrianglesBegin, Triangles.GetData() + Mid, Triangles.GetData() + Pending.End,
+				[&Centroids, Axis](int32 A, int32 B) { return Centroids[A][Axis] < Centroids[B][Axis]; });
+
+			const int32 FirstChild = Nodes.Num();
+			Nodes.AddDefaulted(2);
+			NodeDepth.Add(Pending.Depth + 1);
+			NodeDepth.Add(Pending.Depth + 1);
+			Nodes[Pending.Node].First = FirstChild;
+			Stack.Add({ FirstChild, Pending.Begin, Mid, Pending.Depth + 1 });
+			Stack.Add({ FirstChild + 1, Mid, Pending.End, Pending.Depth + 1 });
+		}
+
+		//Bucket nodes by depth for level-by-level refit
+		int32 MaxDepth = 0;
+		for (int32 Depth : NodeDepth)
+		{
+			MaxDepth = FMath::Max(MaxDepth, Depth);
+		}
+		LevelStarts.Init(0, MaxDepth + 2);
+		for (int32 Depth : NodeDepth)
+		{
+			++LevelStarts[Depth + 1];
+		}
+		for (int32 Depth = 0; Depth <= MaxDepth; ++Depth)
+		{
+			LevelStarts[Depth + 1] += LevelStarts[Depth];
+		}
+		LevelNodes.SetNumUninitialized(Nodes.Num());
+		TArray<int32> Cursor(LevelStarts);
+		for (int32 Node = 0; Node < Nodes.Num(); ++Node)
+		{
+			LevelNodes[Cursor[NodeDepth[Node]]++] = Node;
+		}
+
+		Refit(InRefPositions, false);
+
+		LeafRefBounds.SetNum(Nodes.Num());
+		LeafBones.SetNum(Nodes.Num());
+		LeafMorphExtents.Init(0.f, Nodes.Num());
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+		{
+			const FNode& Node = Nodes[NodeIndex];
+			LeafRefBounds[NodeIndex] = Node.Bounds;
+			if (!Node.IsLeaf())
+			{
+				continue;
+			}
+
+			//Every bone with a non-zero weight on any vertex of the leaf
+			TArray<FBoneIndexType, TInlineAllocator<4>>& Bones = LeafBones[NodeIndex];
+			for (int32 It = Node.First; It < Node.First + Node.NumTriangles; ++It)
+			{
+				for (int32 Corner = 0; Corner < 3; ++Corner)
+				{
+					const int32 FirstInfluence = Indices[Triangles[It] * 3 + Corner] * InMaxInfluences;
+					for (int32 Influence = FirstInfluence; Influence < FirstInfluence + InMaxInfluences; ++Influence)
+					{
+						if (InInfluenceWeights[Influence] > 0)
+						{
+							Bones.AddUnique(InInfluenceBones[Influence]);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	/**
+	* Recompute all node bounds from skinned positions, deepest level first.
+	* @param bParallel: Refit each level with ParallelFor (worth it for large meshes only)
+	**/
+	void Refit(TArrayView<const FVector3f> InPositions, bool bParallel)
+	{
+		for (int32 Level = LevelStarts.Num() - 2; Level >= 0; --Level)
+		{
+			const int32 Begin = LevelStarts[Level];
+			auto RefitNode = [this, &InPositions, Begin](int32 Offset)
+			{
+				FNode& Node = Nodes[LevelNodes[Begin + Offset]];
+				FBox3f Bounds(ForceInit);
+				if (Node.IsLeaf())
+				{
+					for (int32 It = Node.First; It < Node.First + Node.NumTriangles; ++It)
+					{
+						const int32 Triangle = Triangles[It];
+						Bounds += InPositions[Indices[Triangle * 3]];
+						Bounds += InPositions[Indices[Triangle * 3 + 1]];
+						Bounds += InPositions[Indices[Triangle * 3 + 2]];
+					}
+				}
+				else
+				{
+					Bounds = Nodes[Node.First].Bounds + Nodes[Node.First + 1].Bounds;
+				}
+				Node.Bounds = Bounds;
+			};
+
+			const int32 Count = LevelStarts[Level + 1] - Begin;
+			ParallelFor(Count, RefitNode, bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+		}
+	}
+
+	/**
+	* Record how far morph targets can move each leaf's vertices, after Build.
+	* @param InMaxVertexMorphDelta: Per vertex of the LOD, the largest delta length over all morph targets of the mesh
+	**/
+	void SetMorphExtents(TArrayView<const float> InMaxVertexMorphDelta)
+	{
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
+		{
+			const FNode& Node = Nodes[NodeIndex];
+			float Extent = 0.f;
+			for (int32 It = Node.First; Node.IsLeaf() && It < Node.First + Node.NumTriangles; ++It)
+			{
+				for (int32 Corner = 0; Corner < 3; ++Corner)
+				{
+					Extent = FMath::Max(Extent, InMaxVertexMorphDelta[Indices[Triangles[It] * 3 + Corner]]);
+				}
+			}
+			LeafMorphExtents[NodeIndex] = Extent;
+		}
+	}
+
+	/**
+	* Recompute node bounds without skinning any vertex: each leaf takes the union of its reference box transformed by
+	* each influencing bone's ref-to-local matrix. Conservative for linear blend skinning since a skinned vertex is a
+	* convex combination of its bones' transforms of the reference vertex.
+	* @param InMorphWeightSum: Sum of the absolute weights of the active morph targets. A morphed reference vertex moves
+	* by at most this times its largest delta, so each reference box is expanded by InMorphWeightSum * LeafMorphExtents
+	* before being transformed. Not valid while cloth simulates on the LOD: use Refit then
+	**/
+	ENGINE_API void RefitConservative(TArrayView<const FMatrix44f> InRefToLocals, bool bParallel, float InMorphWeightSum = 0.f);
+
+	/**
+	* Trace a segment, skinning only the vertices of visited leaves through InSkinVertex (used after RefitConservative).
+	* @param InSkinVertex: Returns the skinned position of a vertex, morph deltas applied; the caller caches results for the frame
+	* @param OutTriangle: Triangle that was hit
+	* @param OutTime: Hit time along Start->End in [0, 1]
+	**/
+	ENGINE_API bool RaycastLazy(const FVector3f& InStart, const FVector3f& InEnd, TFunctionRef<FVector3f(uint32)> InSkinVertex, int32& OutTriangle, float& OutTime) const;
+
+	//Trace a segment against fully refit bounds and skinned positions
+	ENGINE_API bool Raycast(const FVector3f& InStart, const FVector3f& InEnd, TArrayView<const FVector3f> InPositions, int32& OutTriangle, float& OutTime) const;
+};
@@ -0,0 +1,342 @@
+//Part of openWorldProject. Rebuilds the skeletal mesh task timeline from a crash folder
+//
+//Reads the Breadcrumbs_SkelMeshTasks_<ThreadId>.txt files written by FSkelMeshTaskBreadcrumbs::WriteToCrashContext
+//(see characters/woodChopper/SkeletalMeshTaskBreadcrumbs.h), names threads from CrashContext.runtime-xml and prints
+//the last N frames of task begin/end records merged across threads, then the tasks still running at the crash.
+//
+//Build (Linux, no engine needed):
+//  g++ -O2 -std=c++17 main.cpp -o breadcrumb_timeline
+//
+//Usage:
+//  breadcrumb_timeline [--frames N] <crash folder>...
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	using int32 = std::int32_t;
+	using uint32 = std::uint32_t;
+	using uint64 = std::uint64_t;
+
+	struct FBreadcrumb
+	{
+		uint32 ThreadId = 0;
+		uint32 Frame = 0;
+		uint64 Cycles = 0;
+		bool bBegin = false;
+		std::string Task;
+		uint32 ComponentId = 0;
+		std::string Mesh;
+	};
+
+	struct FThreadInfo
+	{
+		std::string Name = "Unknown";
+		bool bCrashed = false;
+	};
+
+	struct FCrashFolder
+	{
+		std::vector<FBreadcrumb> Breadcrumbs;
+		std::map<uint32, FThreadInfo> Threads;
+		double CyclesPerSecond = 0.0;
+		std::string RHIFrame;
+
+		//Torn lines (records FormatRing could not validate) and lines that did not parse
+		int32 NumTorn = 0;
+	};
+
+	std::string ReadFile(const std::filesystem::path& InPath)
+	{
+		std::ifstream Stream(InPath, std::ios::binary);
+		std::stringstream Buffer;
+		Buffer << Stream.rdbuf();
+		return Buffer.str();
+	}
+
+	//Text between <InTag> and </InTag> starting at InOffset; advances InOffset past the closing tag
+	bool FindElement(const std::string& InText, const char* InTag, size_t& InOffset, std::string& OutValue)
+	{
+		const std::string Open = std::string("<") + InTag + ">";
+		const std::string Close = std::string("</") + InTag + ">";
+		const size_t Start = InText.find(Open, InOffset);
+		if (Start == std::string::npos)
+		{
+			return false;
+		}
+		const size_t End = InText.find(Close, Start + Open.size());
+		if (End == std::string::npos)
+		{
+			return false;
+		}
+		OutValue = InText.substr(Start + Open.size(), End - Start - Open.size());
+		InOffset = End + Close.size();
+		return true;
+	}
+
+	void ParseCrashContext(const std::filesystem::path& InPath, FCrashFolder& OutFolder)
+	{
+		const std::string Text = ReadFile(InPath);
+		size_t Offset = 0;
+		std::string Thread;
+		while (FindElement(Text, "Thread", Offset, Thread))
+		{
+			size_t ThreadOffset = 0;
+			std::string Id, Name, Crashed;
+			if (!FindElement(Thread, "ThreadID", ThreadOffset, Id))
+			{
+				continue;
+			}
+			ThreadOffset = 0;
+			FindElement(Thread, "ThreadName", ThreadOffset, Name);
+			ThreadOffset = 0;
+			FindElement(Thread, "IsCrashed", ThreadOffset, Crashed);
+
+			FThreadInfo& Info = OutFolder.Threads[static_cast<uint32>(std::strtoul(Id.c_str(), nullptr, 10))];
+			Info.Name = Name.empty() ? "Unknown" : Name;
+			Info.bCrashed = Crashed == "true";
+		}
+	}
+
+	void ParseBreadcrumbFile(const std::filesystem::path& InPath, FCrashFolder& OutFolder)
+	{
+		std::ifstream Stream(InPath);
+		std::string Line;
+		uint32 ThreadId = 0;
+		while (std::getline(Stream, Line))
+		{
+			if (!Line.empty() && Line.back() == '\r')
+			{
+				Line.pop_back();
+			}
+
+			if (Line.rfind("Breadcrumbs ", 0) == 0)
+			{
+				const size_t Thread = Line.find("Thread ");
+				ThreadId = Thread != std::string::npos ? static_cast<uint32>(std::strtoul(Line.c_str() + Thread + 7, nullptr, 10)) : 0;
+				continue;
+			}
+			if (Line.rfind("CyclesPerSecond ", 0) == 0)
+			{
+				OutFolder.CyclesPerSecond = std::strtod(Line.c_str() + 16, nullptr);
+				continue;
+			}
+			if (Line.empty())
+			{
+				continue;
+			}
+			if (Line.rfind("Torn ", 0) == 0)
+			{
+				++OutFolder.NumTorn;
+				continue;
+			}
+
+			FBreadcrumb Breadcrumb;
+			Breadcrumb.ThreadId = ThreadId;
+			std::istringstream Fields(Line);
+			std::string Event;
+			if (!(Fields >> Breadcrumb.Frame >> Breadcrumb.Cycles >> Event >> Breadcrumb.Task >> Breadcrumb.ComponentId) || (Event != "B" && Event != "E"))
+			{
+				++OutFolder.NumTorn;
+				continue;
+			}
+			Fields >> Breadcrumb.Mesh;
+			Breadcrumb.bBegin = Event == "B";
+			OutFolder.Breadcrumbs.push_back(std::move(Breadcrumb));
+		}
+	}
+
+	bool LoadCrashFolder(const std::filesystem::path& InFolder, FCrashFolder& OutFolder)
+	{
+		namespace fs = std::filesystem;
+
+		std::error_code Error;
+		bool bFoundBreadcrumbs = false;
+		for (const fs::directory_entry& Entry : fs::directory_iterator(InFolder, Error))
+		{
+			const std::string FileName = Entry.path().filename().string();
+			if (FileName.rfind("Breadcrumbs_SkelMeshTasks_", 0) == 0)
+			{
+				ParseBreadcrumbFile(Entry.path(), OutFolder);
+				bFoundBreadcrumbs = true;
+			}
+			else if (FileName == "CrashContext.runtime-xml")
+			{
+				ParseCrashContext(Entry.path(), OutFolder);
+			}
+			else if (FileName.rfind("Breadcrumbs_RHIThread_", 0) == 0)
+			{
+				//"Breadcrumbs 'RHIThread'" followed by " - Frame N"; keep the frame for context
+				const std::string Text = ReadFile(Entry.path());
+				const size_t Frame = Text.find("Frame ");
+				if (Frame != std::string::npos)
+				{
+					OutFolder.RHIFrame = Text.substr(Frame + 6, Text.find_first_of("\r\n", Frame) - Frame - 6);
+				}
+			}
+		}
+		if (Error)
+		{
+			std::fprintf(stderr, "%s: %s\n", InFolder.string().c_str(), Error.message().c_str());
+			return false;
+		}
+		if (!bFoundBreadcrumbs)
+		{
+			std::fprintf(stderr, "%s: no Breadcrumbs_SkelMeshTasks_*.txt (crash predates task breadcrumbs)\n", InFolder.string().c_str());
+		}
+		return true;
+	}
+
+	const FThreadInfo& GetThread(const FCrashFolder& InFolder, uint32 InThreadId)
+	{
+		static const FThreadInfo UnknownThread;
+		const auto Found = InFolder.Threads.find(InThreadId);
+		return Found != InFolder.Threads.end() ? Found->second : UnknownThread;
+	}
+
+	void PrintTimeline(const FCrashFolder& InFolder, uint32 InNumFrames)
+	{
+		std::vector<FBreadcrumb> Breadcrumbs = InFolder.Breadcrumbs;
+		if (Breadcrumbs.empty())
+		{
+			return;
+		}
+
+		//Cycles64 is a single clock across threads, so a sort merges the rings
+		std::stable_sort(Breadcrumbs.begin(), Breadcrumbs.end(), [](const FBreadcrumb& A, const FBreadcrumb& B) { return A.Cycles < B.Cycles; });
+
+		uint32 LastFrame = 0;
+		for (const FBreadcrumb& Breadcrumb : Breadcrumbs)
+		{
+			LastFrame = std::max(LastFrame, Breadcrumb.Frame);
+		}
+		const uint32 FirstFrame = LastFrame >= InNumFrames ? LastFrame - InNumFrames + 1 : 0;
+		const double MsPerCycle = InFolder.CyclesPerSecond > 0.0 ? 1000.0 / InFolder.CyclesPerSecond : 0.0;
+
+		//Begin records per thread still waiting for their end; tasks do not migrate threads, but they may nest when a worker busy-waits
+		std::map<uint32, std::vector<const FBreadcrumb*>> OpenByThread;
+
+		uint64 WindowStart = 0;
+		uint32 CurrentFrame = ~0u;
+		for (const FBreadcrumb& Breadcrumb : Breadcrumbs)
+		{
+			std::vector<const FBreadcrumb*>& Open = OpenByThread[Breadcrumb.ThreadId];
+			const FBreadcrumb* Begin = nullptr;
+			if (Breadcrumb.bBegin)
+			{
+				Open.push_back(&Breadcrumb);
+			}
+			else
+			{
+				for (auto It = Open.rbegin(); It != Open.rend(); ++It)
+				{
+					if ((*It)->Task == Breadcrumb.Task && (*It)->ComponentId == Breadcrumb.ComponentId)
+					{
+						Begin = *It;
+						Open.erase(std::next(It).base());
+						break;
+					}
+				}
+			}
+
+			if (Breadcrumb.Frame < FirstFrame)
+			{
+				continue;
+			}
+			if (WindowStart == 0)
+			{
+				WindowStart = Breadcrumb.Cycles;
+			}
+			if (Breadcrumb.Frame != CurrentFrame)
+			{
+				CurrentFrame = Breadcrumb.Frame;
+				std::printf("Frame %u\n", CurrentFrame);
+			}
+
+			const FThreadInfo& Thread = GetThread(InFolder, Breadcrumb.ThreadId);
+			std::printf("  %10.3f ms  %-34s %-5s %-36s component %-8u %s", (Breadcrumb.Cycles - WindowStart) * MsPerCycle,
+				(Thread.Name + " (" + std::to_string(Breadcrumb.ThreadId) + ")").c_str(), Breadcrumb.bBegin ? "begin" : "end",
+				Breadcrumb.Task.c_str(), Breadcrumb.ComponentId, Breadcrumb.Mesh.c_str());
+			if (Begin)
+			{
+				std::printf("  (%.3f ms)", (Breadcrumb.Cycles - Begin->Cycles) * MsPerCycle);
+			}
+			std::printf("\n");
+		}
+
+		const uint64 LastCycles = Breadcrumbs.back().Cycles;
+		std::printf("\nRunning at the crash%s:\n", InFolder.RHIFrame.empty() ? "" : (" (RHI thread at frame " + InFolder.RHIFrame + ")").c_str());
+		bool bAnyOpen = false;
+		for (const auto& Pair : OpenByThread)
+		{
+			const FThreadInfo& Thread = GetThread(InFolder, Pair.first);
+			for (const FBreadcrumb* Begin : Pair.second)
+			{
+				bAnyOpen = true;
+				std::printf("  %s%s (%u): %s component %u %s, frame %u, started %.3f ms before the last record\n", Thread.bCrashed ? "CRASHED " : "",
+					Thread.Name.c_str(), Pair.first, Begin->Task.c_str(), Begin->ComponentId, Begin->Mesh.c_str(), Begin->Frame,
+					(LastCycles - Begin->Cycles) * MsPerCycle);
+			}
+		}
+		if (!bAnyOpen)
+		{
+			std::printf("  none\n");
+		}
+		if (InFolder.NumTorn > 0)
+		{
+			std::printf("  %d torn record(s) skipped (written while the crash happened)\n", InFolder.NumTorn);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	uint32 NumFrames = 3;
+	std::vector<std::string> Folders;
+	for (int Arg = 1; Arg < argc; ++Arg)
+	{
+		if (std::strcmp(argv[Arg], "--frames") == 0 && Arg + 1 < argc)
+		{
+			NumFrames = static_cast<uint32>(std::max(1, std::atoi(argv[++Arg])));
+		}
+		else if (argv[Arg][0] == '-')
+		{
+			std::fprintf(stderr, "usage: breadcrumb_timeline [--frames N] <crash folder>...\n");
+			return 2;
+		}
+		else
+		{
+			Folders.push_back(argv[Arg]);
+		}
+	}
+
+	if (Folders.empty())
+	{
+		std::fprintf(stderr, "usage: breadcrumb_timeline [--frames N] <crash folder>...\n");
+		return 2;
+	}
+
+	int Result = 0;
+	for (const std::string& Folder : Folders)
+	{
+		FCrashFolder Crash;
+		if (!LoadCrashFolder(Folder, Crash))
+		{
+			Result = 1;
+			continue;
+		}
+		std::printf("== %s\n", Folder.c_str());
+		PrintTimeline(Crash, NumFrames);
+	}
+	return Result;
+}
@@ -0,0 +1,596 @@
+//Part of openWorldProject. Offline reader for Unreal package (.uasset/.umap) headers, no editor required
+
+#include "UAssetIndexer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace UAssetIndexer
+{
+	namespace
+	{
+		//Serialized size of an FObjectImport record, which depends on the package version and editor only filtering
+		int32 GetImportRecordSize(const FPackageSummary& InSummary)
+		{
+			int32 Size = 8 + 8 + 4 + 8;
+			if (!InSummary.IsFilterEditorOnly())
+			{
+				Size += 8; //PackageName
+			}
+			if (InSummary.IsAtLeast(EUE5Version::OptionalResources))
+			{
+				Size += 4; //bImportOptional
+			}
+			return Size;
+		}
+
+		/** Bounds checked little endian cursor over the mapping. Any out of range read sets bError and returns zeros */
+		struct FReader
+		{
+			const uint8* Data = nullptr;
+			size_t Size = 0;
+			size_t Offset = 0;
+			bool bError = false;
+
+			FReader(const uint8* InData, size_t InSize, size_t InOffset = 0) : Data(InData), Size(InSize), Offset(InOffset)
+			{
+				bError = InOffset > InSize;
+			}
+
+			bool Has(size_t InBytes) const { return !bError && InBytes <= Size - Offset; }
+
+			template<typename T>
+			T Read()
+			{
+				T Value{};
+				if (!Has(sizeof(T)))
+				{
+					bError = true;
+					return Value;
+				}
+				std::memcpy(&Value, Data + Offset, sizeof(T));
+				Offset += sizeof(T);
+				return Value;
+			}
+
+			int32 ReadInt32() { return Read<int32>(); }
+			uint32 ReadUInt32() { return Read<uint32>(); }
+			int64 ReadInt64() { return Read<int64>(); }
+			bool ReadBool() { return Read<uint32>() != 0; }
+
+			void Skip(size_t InBytes)
+			{
+				if (!Has(InBytes))
+				{
+					bError = true;
+					return;
+				}
+				Offset += InBytes;
+			}
+
+			FNameRef ReadName()
+			{
+				FNameRef Name;
+				Name.Index = ReadInt32();
+				Name.Number = ReadInt32();
+				return Name;
+			}
+
+			//FString as a view into the mapping: int32 length including terminator, negative for UTF-16
+			FNameEntryView ReadStringView()
+			{
+				FNameEntryView Entry;
+				const int32 Length = ReadInt32();
+				if (Length == 0 || bError)
+				{
+					return Entry;
+				}
+				Entry.bWide = Length < 0;
+				const int64 Units = Length < 0 ? -static_cast<int64>(Length) : Length;
+				const size_t Bytes = static_cast<size_t>(Units) * (Entry.bWide ? 2 : 1);
+				if (Units > (1 << 20) || !Has(Bytes))
+				{
+					bError = true;
+					return Entry;
+				}
+				Entry.Data = reinterpret_cast<const char*>(Data + Offset);
+				Entry.Length = static_cast<int32>(Units - 1);
+				Offset += Bytes;
+				return Entry;
+			}
+
+			void SkipString() { ReadStringView(); }
+		};
+
+		bool IsScriptPackage(std::string_view InName)
+		{
+			return InName.size() >= 8 && InName.compare(0, 8, "/Script/") == 0;
+		}
+	}
+
+	std::string FNameEntryView::ToString() const
+	{
+		if (!bWide)
+		{
+			return std::string(Data ? Data : "", Length);
+		}
+
+		//UTF-16 to UTF-8 (names are BMP only in practice; surrogates are passed through as separate code points)
+		std::string Out;
+		Out.reserve(Length);
+		for (int32 It = 0; It < Length; ++It)
+		{
+			uint16 Unit;
+			std::memcpy(&Unit, Data + It * 2, 2);
+			if (Unit < 0x80)
+			{
+				Out += static_cast<char>(Unit);
+			}
+			else if (Unit < 0x800)
+			{
+				Out += static_cast<char>(0xC0 | (Unit >> 6));
+				Out += static_cast<char>(0x80 | (Unit & 0x3F));
+			}
+			else
+			{
+				Out += static_cast<char>(0xE0 | (Unit >> 12));
+				Out += static_cast<char>(0x80 | ((Unit >> 6) & 0x3F));
+				Out += static_cast<char>(0x80 | (Unit & 0x3F));
+			}
+		}
+		return Out;
+	}
+
+	FMappedFile::~FMappedFile()
+	{
+		Close();
+	}
+
+	FMappedFile::FMappedFile(FMappedFile&& Other) noexcept : Data(Other.Data), Size(Other.Size)
+	{
+		Other.Data = nullptr;
+		Other.Size = 0;
+	}
+
+	FMappedFile& FMappedFile::operator=(FMappedFile&& Other) noexcept
+	{
+		if (this != &Other)
+		{
+			Close();
+			Data = Other.Data;
+			Size = Other.Size;
+			Other.Data = nullptr;
+			Other.Size = 0;
+		}
+		return *this;
+	}
+
+	bool FMappedFile::Open(const std::string& InPath, std::string& OutError)
+	{
+		Close();
+
+		const int Handle = ::open(InPath.c_str(), O_RDONLY | O_CLOEXEC);
+		if (Handle < 0)
+		{
+			OutError = "cannot open file";
+			return false;
+		}
+
+		struct stat Stat;
+		if (::fstat(Handle, &Stat) != 0 || Stat.st_size <= 0)
+		{
+			::close(Handle);
+			OutError = "empty or unreadable file";
+			return false;
+		}
+
+		void* Mapping = ::mmap(nullptr, static_cast<size_t>(Stat.st_size), PROT_READ, MAP_PRIVATE, Handle, 0);
+		::close(Handle);
+		if (Mapping == MAP_FAILED)
+		{
+			OutError = "mmap failed";
+			return false;
+		}
+
+		Data = static_cast<const uint8*>(Mapping);
+		Size = static_cast<size_t>(Stat.st_size);
+
+		//Only the header is read, and front to back
+		::madvise(Mapping, Size, MADV_SEQUENTIAL);
+		return true;
+	}
+
+	void FMappedFile::Close()
+	{
+		if (Data)
+		{
+			::munmap(const_cast<uint8*>(Data), Size);
+			Data = nullptr;
+			Size = 0;
+		}
+	}
+
+	bool FPackageHeader::Load(const std::string& InPath, std::string& OutError)
+	{
+		Path = InPath;
+		return File.Open(InPath, OutError)
+			&& ParseSummary(OutError)
+			&& ParseNames(OutError)
+			&& ParseImports(OutError)
+			&& ParseExports(OutError)
+			&& ParseSoftPackageReferences(OutError);
+	}
+
+	bool FPackageHeader::ParseSummary(std::string& OutError)
+	{
+		FReader Reader(File.GetData(), File.GetSize());
+
+		if (File.GetSize() < 64)
+		{
+			OutError = "file too small to be a package";
+			return false;
+		}
+		if (Reader.ReadUInt32() != PackageFileTag)
+		{
+			OutError = "not a package (bad tag)";
+			return false;
+		}
+
+		Summary.LegacyFileVersion = Reader.ReadInt32();
+		if (Summary.LegacyFileVersion >= 0 || Summary.LegacyFileVersion < -8)
+		{
+			OutError = "unsupported legacy file version " + std::to_string(Summary.LegacyFileVersion);
+			return false;
+		}
+		if (Summary.LegacyFileVersion != -4)
+		{
+			Reader.ReadInt32(); //LegacyUE3Version
+		}
+		Summary.FileVersionUE4 = Reader.ReadInt32();
+		if (Summary.LegacyFileVersion <= -8)
+		{
+			Summary.FileVersionUE5 = Reader.ReadInt32();
+		}
+		Summary.FileVersionLicenseeUE4 = Reader.ReadInt32();
+
+		//Unversioned (cooked) packages need the engine's version to be parsed and are not supported
+		if (Summary.FileVersionUE4 == 0 && Summary.FileVersionUE5 == 0)
+		{
+			OutError = "unversioned package";
+			return false;
+		}
+
+		//Only UE5 editor packages are supported; older layouts have extra or missing summary fields
+		if (Summary.FileVersionUE5 < 1000)
+		{
+			OutError = "pre-UE5 package (UE4 version " + std::to_string(Summary.FileVersionUE4) + ")";
+			return false;
+		}
+
+		//Custom versions: FGuid + int32 each
+		const int32 NumCustomVersions = Reader.ReadInt32();
+		if (NumCustomVersions < 0 || NumCustomVersions > 4096)
+		{
+			OutError = "bad custom version count";
+			return false;
+		}
+		Reader.Skip(static_cast<size_t>(NumCustomVersions) * 20);
+
+		if (Summary.IsAtLeast(EUE5Version::PackageSavedHash))
+		{
+			Reader.Skip(20); //SavedHash
+		}
+		Summary.TotalHeaderSize = Reader.ReadInt32();
+		Summary.PackageName = Reader.ReadStringView().View();
+		Summary.PackageFlags = Reader.ReadUInt32();
+		Summary.NameCount = Reader.ReadInt32();
+		Summary.NameOffset = Reader.ReadInt32();
+		if (Summary.IsAtLeast(EUE5Version::AddSoftObjectPathList))
+		{
+			Summary.SoftObjectPathsCount = Reader.ReadInt32();
+			Summary.SoftObjectPathsOffset = Reader.ReadInt32();
+		}
+		if (!Summary.IsFilterEditorOnly())
+		{
+			Reader.SkipString(); //LocalizationId
+		}
+		Reader.Skip(8); //GatherableTextDataCount, GatherableTextDataOffset
+		Summary.ExportCount = Reader.ReadInt32();
+		Summary.ExportOffset = Reader.ReadInt32();
+		Summary.ImportCount = Reader.ReadInt32();
+		Summary.ImportOffset = Reader.ReadInt32();
+		if (Summary.IsAtLeast(EUE5Version::VerseCells))
+		{
+			Reader.Skip(16); //CellExportCount/Offset, CellImportCount/Offset
+		}
+		if (Summary.IsAtLeast(EUE5Version::MetaDataSerializationOffset))
+		{
+			Reader.Skip(4); //MetaDataOffset
+		}
+		Summary.DependsOffset = Reader.ReadInt32();
+		Summary.SoftPackageReferencesCount = Reader.ReadInt32();
+		Summary.SoftPackageReferencesOffset = Reader.ReadInt32();
+
+		//The rest of the summary (searchable names, thumbnails, generations, engine versions, chunk ids...) is not needed
+
+		if (Reader.bError)
+		{
+			OutError = "truncated summary";
+			return false;
+		}
+		if (Summary.NameCount < 0 || Summary.ImportCount < 0 || Summary.ExportCount < 0 || Summary.SoftPackageReferencesCount < 0)
+		{
+			OutError = "negative table count";
+			return false;
+		}
+		return true;
+	}
+
+	bool FPackageHeader::ParseNames(std::string& OutError)
+	{
+		FReader Reader(File.GetData(), File.GetSize(), static_cast<uint32>(Summary.NameOffset));
+		Names.resize(Summary.NameCount);
+		for (FNameEntryView& Entry : Names)
+		{
+			Entry = Reader.ReadStringView();
+			Reader.Skip(4); //NonCasePreservingHash, CasePreservingHash
+		}
+		if (Reader.bError)
+		{
+			OutError = "truncated name table";
+			return false;
+		}
+		return true;
+	}
+
+	bool FPackageHeader::ParseImports(std::string& OutError)
+	{
+		const size_t RecordSize = GetImportRecordSize(Summary);
+		FReader Reader(File.GetData(), File.GetSize(), static_cast<uint32>(Summary.ImportOffset));
+		if (!Reader.Has(RecordSize * Summary.ImportCount))
+		{
+			OutError = "truncated import table";
+			return false;
+		}
+
+		Imports.resize(Summary.ImportCount);
+		for (FImportView& Import : Imports)
+		{
+			const size_t Start = Reader.Offset;
+			Import.ClassPackage = Reader.ReadName();
+			Import.ClassName = Reader.ReadName();
+			Import.OuterIndex = Reader.ReadInt32();
+			Import.ObjectName = Reader.ReadName();
+			if (!Summary.IsFilterEditorOnly())
+			{
+				Reader.Skip(8); //PackageName
+			}
+			if (Summary.IsAtLeast(EUE5Version::OptionalResources))
+			{
+				Import.bOptional = Reader.ReadBool();
+			}
+			Reader.Offset = Start + RecordSize;
+		}
+		return true;
+	}
+
+	bool FPackageHeader::ParseExports(std::string& OutError)
+	{
+		FReader Reader(File.GetData(), File.GetSize(), static_cast<uint32>(Summary.ExportOffset));
+		Exports.resize(Summary.ExportCount);
+		for (FExportView& Export : Exports)
+		{
+			Export.ClassIndex = Reader.ReadInt32();
+			Export.SuperIndex = Reader.ReadInt32();
+			Reader.Skip(4); //TemplateIndex
+			Export.OuterIndex = Reader.ReadInt32();
+			Export.ObjectName = Reader.ReadName();
+			Reader.Skip(4); //ObjectFlags
+			Export.SerialSize = Reader.ReadInt64();
+			Export.SerialOffset = Reader.ReadInt64();
+			Reader.Skip(12); //bForcedExport, bNotForClient, bNotForServer
+			if (!Summary.IsAtLeast(EUE5Version::RemoveObjectExportPackageGuid))
+			{
+				Reader.Skip(16); //PackageGuid
+			}
+			if (Summary.IsAtLeast(EUE5Version::TrackObjectExportIsInherited))
+			{
+				Reader.Skip(4); //bIsInheritedInstance
+			}
+			Reader.Skip(8); //PackageFlags, bNotAlwaysLoadedForEditorGame
+			Export.bIsAsset = Reader.ReadBool();
+			if (Summary.IsAtLeast(EUE5Version::OptionalResources))
+			{
+				Reader.Skip(4); //bGeneratePublicHash
+			}
+			Reader.Skip(20); //FirstExportDependency and the four dependency counts
+			if (Summary.IsAtLeast(EUE5Version::ScriptSerializationOffset))
+			{
+				Reader.Skip(16); //ScriptSerializationStartOffset, ScriptSerializationEndOffset
+			}
+		}
+		if (Reader.bError)
+		{
+			OutError = "truncated export table";
+			return false;
+		}
+		return true;
+	}
+
+	bool FPackageHeader::ParseSoftPackageReferences(std::string& OutError)
+	{
+		if (Summary.SoftPackageReferencesCount == 0)
+		{
+			return true;
+		}
+		FReader Reader(File.GetData(), File.GetSize(), static_cast<uint32>(Summary.SoftPackageReferencesOffset));
+		SoftPackageReferences.resize(Summary.SoftPackageReferencesCount);
+		for (FNameRef& Reference : SoftPackageReferences)
+		{
+			Reference = Reader.ReadName();
+		}
+		if (Reader.bError)
+		{
+			OutError = "truncated soft package references";
+			return false;
+		}
+		return true;
+	}
+
+	std::string FPackageHeader::GetNameString(const FNameRef& InName) const
+	{
+		if (InName.Index < 0 || InName.Index >= static_cast<int32>(Names.size()))
+		{
+			return "None";
+		}
+		std::string Out = Names[InName.Index].ToString();
+		if (InName.Number > 0)
+		{
+			Out += '_';
+			Out += std::to_string(InName.Number - 1);
+		}
+		return Out;
+	}
+
+	std::string_view FPackageHeader::GetNameView(const FNameRef& InName) const
+	{
+		if (InName.Index < 0 || InName.Index >= static_cast<int32>(Names.size()))
+		{
+			return std::string_view();
+		}
+		return Names[InName.Index].View();
+	}
+
+	void FPackageHeader::GetImportedPackages(std::vector<std::string_view>& OutPackages, bool bIncludeScript) const
+	{
+		for (const FImportView& Import : Imports)
+		{
+			if (Import.OuterIndex != 0 || GetNameView(Import.ClassName) != "Package")
+			{
+				continue;
+			}
+			const std::string_view Name = GetNameView(Import.ObjectName);
+			if (!Name.empty() && (bIncludeScript || !IsScriptPackage(Name)))
+			{
+				OutPackages.push_back(Name);
+			}
+		}
+	}
+
+	void FDependencyGraph::Build(const std::vector<std::string>& InPaths, int32 InNumThreads, bool bIncludeScript)
+	{
+		const int32 NumPaths = static_cast<int32>(InPaths.size());
+		const int32 NumThreads = std::max(1, std::min(NumPaths, InNumThreads > 0 ? InNumThreads : static_cast<int32>(std::thread::hardware_concurrency())));
+
+		//Load headers: workers pull indices from a shared counter so large packages do not stall a fixed partition
+		std::vector<FPackageHeader> Loaded(NumPaths);
+		std::vector<std::string> Errors(NumPaths);
+		std::vector<uint8> bLoaded(NumPaths, 0);
+		std::atomic<int32> NextPath{ 0 };
+		auto LoadWorker = [&]()
+		{
+			for (int32 Index = NextPath++; Index < NumPaths; Index = NextPath++)
+			{
+				bLoaded[Index] = Loaded[Index].Load(InPaths[Index], Errors[Index]) ? 1 : 0;
+			}
+		};
+
+		std::vector<std::thread> Threads;
+		for (int32 Thread = 1; Thread < NumThreads; ++Thread)
+		{
+			Threads.emplace_back(LoadWorker);
+		}
+		LoadWorker();
+		for (std::thread& Thread : Threads)
+		{
+			Thread.join();
+		}
+
+		Packages.clear();
+		Failures.clear();
+		Dependencies.clear();
+		for (int32 Index = 0; Index < NumPaths; ++Index)
+		{
+			if (bLoaded[Index])
+			{
+				Packages.push_back(std::move(Loaded[Index]));
+			}
+			else
+			{
+				Failures.emplace_back(InPaths[Index], std::move(Errors[Index]));
+			}
+		}
+
+		//Link edges by package name. Views stay valid: FPackageHeader moves keep the mapping
+		std::unordered_map<std::string_view, int32> PackageByName;
+		PackageByName.reserve(Packages.size());
+		for (int32 Index = 0; Index < static_cast<int32>(Packages.size()); ++Index)
+		{
+			PackageByName.emplace(Packages[Index].GetSummary().PackageName, Index);
+		}
+
+		std::vector<std::string_view> Targets;
+		for (int32 Index = 0; Index < static_cast<int32>(Packages.size()); ++Index)
+		{
+			const FPackageHeader& Package = Packages[Index];
+
+			Targets.clear();
+			Package.GetImportedPackages(Targets, bIncludeScript);
+			const size_t NumHard = Targets.size();
+			for (const FNameRef& Reference : Package.GetSoftPackageReferences())
+			{
+				//Editor packages list themselves here when they hold soft paths to their own objects
+				const std::string_view Name = Package.GetNameView(Reference);
+				if (!Name.empty() && Name != Package.GetSummary().PackageName && (bIncludeScript || !IsScriptPackage(Name)))
+				{
+					Targets.push_back(Name);
+				}
+			}
+
+			for (size_t Target = 0; Target < Targets.size(); ++Target)
+			{
+				FDependency Dependency;
+				Dependency.From = Index;
+				Dependency.Target = Targets[Target];
+				Dependency.bSoft = Target >= NumHard;
+				const auto Found = PackageByName.find(Targets[Target]);
+				Dependency.To = Found != PackageByName.end() ? Found->second : -1;
+				Dependencies.push_back(Dependency);
+			}
+		}
+	}
+
+	void FindPackages(const std::string& InRoot, std::vector<std::string>& OutPaths)
+	{
+		namespace fs = std::filesystem;
+
+		auto IsPackage = [](const fs::path& InPath)
+		{
+			const std::string Extension = InPath.extension().string();
+			return Extension == ".uasset" || Extension == ".umap";
+		};
+
+		std::error_code Error;
+		if (fs::is_regular_file(InRoot, Error))
+		{
+			OutPaths.push_back(InRoot);
+			return;
+		}
+
+		for (fs::recursive_directory_iterator It(InRoot, fs::directory_options::skip_permission_denied, Error), End; !Error && It != End; It.increment(Error))
+		{
+			if (It->is_regular_file(Error) && IsPackage(It->path()))
+			{
+				OutPaths.push_back(It->path().string());
+			}
+		}
+	}
+}
@@ -0,0 +1,217 @@
+//Part of openWorldProject. Offline reader for Unreal package (.uasset/.umap) headers, no editor required
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace UAssetIndexer
+{
+	using int32 = std::int32_t;
+	using int64 = std::int64_t;
+	using uint8 = std::uint8_t;
+	using uint16 = std::uint16_t;
+	using uint32 = std::uint32_t;
+
+	constexpr uint32 PackageFileTag = 0x9E2A83C1;
+
+	//EUnrealEngineObjectUE5Version entries that change the header layout
+	enum class EUE5Version : int32
+	{
+		NamesReferencedFromExportData = 1001,
+		PayloadToc = 1002,
+		OptionalResources = 1003,
+		RemoveObjectExportPackageGuid = 1005,
+		TrackObjectExportIsInherited = 1006,
+		AddSoftObjectPathList = 1008,
+		DataResources = 1009,
+		ScriptSerializationOffset = 1010,
+		MetaDataSerializationOffset = 1014,
+		VerseCells = 1015,
+		PackageSavedHash = 1016,
+	};
+
+	//PKG_FilterEditorOnly: package was saved without editor only data (cooked), several summary fields are absent
+	constexpr uint32 PKG_FilterEditorOnly = 0x80000000;
+
+	/**
+	* Entry of the name table. Points straight into the mapped file; Length excludes the terminator.
+	* Wide entries are UTF-16 and Length counts code units.
+	**/
+	struct FNameEntryView
+	{
+		const char* Data = nullptr;
+		int32 Length = 0;
+		bool bWide = false;
+
+		//Narrow entries only; wide entries return an empty view (use ToString)
+		std::string_view View() const { return bWide ? std::string_view() : std::string_view(Data, Length); }
+
+		//UTF-8 copy, for output only
+		std::string ToString() const;
+	};
+
+	//FName as serialized: an index into the name table plus an instance number (0 = no suffix)
+	struct FNameRef
+	{
+		int32 Index = 0;
+		int32 Number = 0;
+	};
+
+	//FObjectImport fields needed for dependency scans. OuterIndex is an FPackageIndex (0 = none, < 0 = import, > 0 = export)
+	struct FImportView
+	{
+		FNameRef ClassPackage;
+		FNameRef ClassName;
+		int32 OuterIndex = 0;
+		FNameRef ObjectName;
+		bool bOptional = false;
+	};
+
+	//FObjectExport fields needed for dependency scans
+	struct FExportView
+	{
+		int32 ClassIndex = 0;
+		int32 SuperIndex = 0;
+		int32 OuterIndex = 0;
+		FNameRef ObjectName;
+		int64 SerialSize = 0;
+		int64 SerialOffset = 0;
+		bool bIsAsset = false;
+	};
+
+	/** The parts of FPackageFileSummary the indexer reads */
+	struct FPackageSummary
+	{
+		int32 LegacyFileVersion = 0;
+		int32 FileVersionUE4 = 0;
+		int32 FileVersionUE5 = 0;
+		int32 FileVersionLicenseeUE4 = 0;
+		int32 TotalHeaderSize = 0;
+		std::string_view PackageName;
+		uint32 PackageFlags = 0;
+		int32 NameCount = 0, NameOffset = 0;
+		int32 SoftObjectPathsCount = 0, SoftObjectPathsOffset = 0;
+		int32 ExportCount = 0, ExportOffset = 0;
+		int32 ImportCount = 0, ImportOffset = 0;
+		int32 DependsOffset = 0;
+		int32 SoftPackageReferencesCount = 0, SoftPackageReferencesOffset = 0;
+
+		bool IsFilterEditorOnly() const { return (PackageFlags & PKG_FilterEditorOnly) != 0; }
+		bool IsAtLeast(EUE5Version InVersion) const { return FileVersionUE5 >= static_cast<int32>(InVersion); }
+	};
+
+	/**
+	* Read only memory mapping of one file. Move only; the mapping is released with the object.
+	**/
+	class FMappedFile
+	{
+	public:
+		FMappedFile() = default;
+		~FMappedFile();
+		FMappedFile(FMappedFile&& Other) noexcept;
+		FMappedFile& operator=(FMappedFile&& Other) noexcept;
+		FMappedFile(const FMappedFile&) = delete;
+		FMappedFile& operator=(const FMappedFile&) = delete;
+
+		//Map InPath. Returns false and fills OutError on failure
+		bool Open(const std::string& InPath, std::string& OutError);
+
+		const uint8* GetData() const { return Data; }
+		size_t GetSize() const { return Size; }
+
+	private:
+		void Close();
+
+		const uint8* Data = nullptr;
+		size_t Size = 0;
+	};
+
+	/**
+	* Header of one package: summary, name, import and export tables.
+	* Names and the package name are views into the mapping, so the package must outlive every view taken from it.
+	* Import and export records are decoded from the mapping into small fixed size views; nothing else is copied.
+	**/
+	class FPackageHeader
+	{
+	public:
+		/**
+		* Map and parse a package header.
+		* @param InPath: .uasset or .umap file
+		* @param OutError: Reason on failure (bad tag, unsupported version, truncated table)
+		**/
+		bool Load(const std::string& InPath, std::string& OutError);
+
+		const FPackageSummary& GetSummary() const { return Summary; }
+		const std::vector<FNameEntryView>& GetNames() const { return Names; }
+		const std::vector<FImportView>& GetImports() const { return Imports; }
+		const std::vector<FExportView>& GetExports() const { return Exports; }
+		const std::vector<FNameRef>& GetSoftPackageReferences() const { return SoftPackageReferences; }
+		const std::string& GetPath() const { return Path; }
+
+		//Name with its instance suffix (Name_N-1 when Number > 0). Returns "None" for out of range indices
+		std::string GetNameString(const FNameRef& InName) const;
+
+		//Narrow name without the suffix, no copy. Empty for wide or out of range entries
+		std::string_view GetNameView(const FNameRef& InName) const;
+
+		/**
+		* Packages this package imports from: every import whose outer is null and class is "Package".
+		* @param bIncludeScript: Also return native /Script/ packages
+		**/
+		void GetImportedPackages(std::vector<std::string_view>& OutPackages, bool bIncludeScript) const;
+
+	private:
+		bool ParseSummary(std::string& OutError);
+		bool ParseNames(std::string& OutError);
+		bool ParseImports(std::string& OutError);
+		bool ParseExports(std::string& OutError);
+		bool ParseSoftPackageReferences(std::string& OutError);
+
+		FMappedFile File;
+		std::string Path;
+		FPackageSummary Summary;
+		std::vector<FNameEntryView> Names;
+		std::vector<FImportView> Imports;
+		std::vector<FExportView> Exports;
+		std::vector<FNameRef> SoftPackageReferences;
+	};
+
+	/** One edge of the dependency graph */
+	struct FDependency
+	{
+		//Index of the dependent package in FDependencyGraph::Packages
+		int32 From = 0;
+
+		//Imported package name; To is its index in Packages when it was part of the scan, -1 otherwise
+		std::string_view Target;
+		int32 To = -1;
+
+		//Soft reference (SoftPackageReferences) rather than a hard import
+		bool bSoft = false;
+	};
+
+	/** Dependency graph over a set of packages, built in parallel */
+	struct FDependencyGraph
+	{
+		std::vector<FPackageHeader> Packages;
+
+		//Paths that failed to load and the reason
+		std::vector<std::pair<std::string, std::string>> Failures;
+
+		std::vector<FDependency> Dependencies;
+
+		/**
+		* Load every path on InNumThreads threads (0 = hardware concurrency) and link imports to scanned packages by name.
+		* @param bIncludeScript: Keep edges to native /Script/ packages
+		**/
+		void Build(const std::vector<std::string>& InPaths, int32 InNumThreads, bool bIncludeScript);
+	};
+
+	//Recursively collect .uasset and .umap files under InRoot (or InRoot itself if it is a file)
+	void FindPackages(const std::string& InRoot, std::vector<std::string>& OutPaths);
+}
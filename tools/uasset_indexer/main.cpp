@@ -0,0 +1,211 @@
+//Part of openWorldProject. Command line front end for UAssetIndexer
+//
+//Build (Linux, no engine needed):
+//  g++ -O2 -std=c++17 -pthread UAssetIndexer.cpp main.cpp -o uasset_indexer
+//
+//Usage:
+//  uasset_indexer [options] <file or directory>...
+//    --format tsv|dot   Dependency graph output (default tsv: from, to, hard|soft, scanned|external)
+//    --dump             Print summary, imports and exports of each package instead of the graph
+//    --script           Keep edges to native /Script/ packages
+//    --threads N        Worker threads (default: hardware concurrency)
+//    --bench N          Build the graph N times and report packages per second (no graph output)
+
+#include "UAssetIndexer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace UAssetIndexer;
+
+namespace
+{
+	void PrintUsage()
+	{
+		std::fprintf(stderr, "usage: uasset_indexer [--format tsv|dot] [--dump] [--script] [--threads N] [--bench N] <file or directory>...\n");
+	}
+
+	std::string ObjectPath(const FPackageHeader& InPackage, int32 InPackageIndex)
+	{
+		if (InPackageIndex < 0 && -InPackageIndex - 1 < static_cast<int32>(InPackage.GetImports().size()))
+		{
+			return InPackage.GetNameString(InPackage.GetImports()[-InPackageIndex - 1].ObjectName);
+		}
+		if (InPackageIndex > 0 && InPackageIndex - 1 < static_cast<int32>(InPackage.GetExports().size()))
+		{
+			return InPackage.GetNameString(InPackage.GetExports()[InPackageIndex - 1].ObjectName);
+		}
+		return "None";
+	}
+
+	void DumpPackage(const FPackageHeader& InPackage)
+	{
+		const FPackageSummary& Summary = InPackage.GetSummary();
+		std::printf("%s\n", InPackage.GetPath().c_str());
+		std::printf("  package %.*s  UE4 %d  UE5 %d  flags 0x%08x  header %d bytes\n", static_cast<int>(Summary.PackageName.size()), Summary.PackageName.data(),
+			Summary.FileVersionUE4, Summary.FileVersionUE5, Summary.PackageFlags, Summary.TotalHeaderSize);
+		std::printf("  names %d  imports %d  exports %d  soft package references %d\n", Summary.NameCount, Summary.ImportCount, Summary.ExportCount, Summary.SoftPackageReferencesCount);
+
+		const std::vector<FImportView>& Imports = InPackage.GetImports();
+		for (size_t Index = 0; Index < Imports.size(); ++Index)
+		{
+			const FImportView& Import = Imports[Index];
+			std::printf("  import %-4zd %s'%s' outer %s\n", -static_cast<ptrdiff_t>(Index) - 1, InPackage.GetNameString(Import.ClassName).c_str(),
+				InPackage.GetNameString(Import.ObjectName).c_str(), ObjectPath(InPackage, Import.OuterIndex).c_str());
+		}
+
+		const std::vector<FExportView>& Exports = InPackage.GetExports();
+		for (size_t Index = 0; Index < Exports.size(); ++Index)
+		{
+			const FExportView& Export = Exports[Index];
+			std::printf("  export %-4zu %s'%s' outer %s  %lld bytes at %lld%s\n", Index + 1, ObjectPath(InPackage, Export.ClassIndex).c_str(),
+				InPackage.GetNameString(Export.ObjectName).c_str(), ObjectPath(InPackage, Export.OuterIndex).c_str(),
+				static_cast<long long>(Export.SerialSize), static_cast<long long>(Export.SerialOffset), Export.bIsAsset ? "  (asset)" : "");
+		}
+
+		for (const FNameRef& Reference : InPackage.GetSoftPackageReferences())
+		{
+			std::printf("  soft   %s\n", InPackage.GetNameString(Reference).c_str());
+		}
+	}
+
+	void PrintGraphTsv(const FDependencyGraph& InGraph)
+	{
+		for (const FDependency& Dependency : InGraph.Dependencies)
+		{
+			const std::string_view From = InGraph.Packages[Dependency.From].GetSummary().PackageName;
+			std::printf("%.*s\t%.*s\t%s\t%s\n", static_cast<int>(From.size()), From.data(), static_cast<int>(Dependency.Target.size()), Dependency.Target.data(),
+				Dependency.bSoft ? "soft" : "hard", Dependency.To >= 0 ? "scanned" : "external");
+		}
+	}
+
+	void PrintGraphDot(const FDependencyGraph& InGraph)
+	{
+		std::printf("digraph packages {\n  rankdir=LR;\n  node [shape=box];\n");
+		for (const FPackageHeader& Package : InGraph.Packages)
+		{
+			const std::string_view Name = Package.GetSummary().PackageName;
+			std::printf("  \"%.*s\" [style=filled];\n", static_cast<int>(Name.size()), Name.data());
+		}
+		for (const FDependency& Dependency : InGraph.Dependencies)
+		{
+			const std::string_view From = InGraph.Packages[Dependency.From].GetSummary().PackageName;
+			std::printf("  \"%.*s\" -> \"%.*s\"%s;\n", static_cast<int>(From.size()), From.data(), static_cast<int>(Dependency.Target.size()), Dependency.Target.data(),
+				Dependency.bSoft ? " [style=dashed]" : "");
+		}
+		std::printf("}\n");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> Roots;
+	bool bDump = false;
+	bool bIncludeScript = false;
+	bool bDot = false;
+	int32 NumThreads = 0;
+	int32 BenchIterations = 0;
+
+	for (int Arg = 1; Arg < argc; ++Arg)
+	{
+		const char* Option = argv[Arg];
+		if (std::strcmp(Option, "--dump") == 0)
+		{
+			bDump = true;
+		}
+		else if (std::strcmp(Option, "--script") == 0)
+		{
+			bIncludeScript = true;
+		}
+		else if (std::strcmp(Option, "--format") == 0 && Arg + 1 < argc)
+		{
+			const char* Format = argv[++Arg];
+			if (std::strcmp(Format, "dot") != 0 && std::strcmp(Format, "tsv") != 0)
+			{
+				PrintUsage();
+				return 2;
+			}
+			bDot = std::strcmp(Format, "dot") == 0;
+		}
+		else if (std::strcmp(Option, "--threads") == 0 && Arg + 1 < argc)
+		{
+			NumThreads = std::atoi(argv[++Arg]);
+		}
+		else if (std::strcmp(Option, "--bench") == 0 && Arg + 1 < argc)
+		{
+			BenchIterations = std::atoi(argv[++Arg]);
+		}
+		else if (Option[0] == '-')
+		{
+			PrintUsage();
+			return 2;
+		}
+		else
+		{
+			Roots.push_back(Option);
+		}
+	}
+
+	if (Roots.empty())
+	{
+		PrintUsage();
+		return 2;
+	}
+
+	std::vector<std::string> Paths;
+	for (const std::string& Root : Roots)
+	{
+		FindPackages(Root, Paths);
+	}
+
+	if (BenchIterations > 0)
+	{
+		//Each iteration maps, parses and links every package again; the page cache is warm after the first one
+		size_t NumPackages = 0;
+		size_t NumBytes = 0;
+		const auto Start = std::chrono::steady_clock::now();
+		for (int32 Iteration = 0; Iteration < BenchIterations; ++Iteration)
+		{
+			FDependencyGraph Graph;
+			Graph.Build(Paths, NumThreads, bIncludeScript);
+			NumPackages += Graph.Packages.size();
+			for (const FPackageHeader& Package : Graph.Packages)
+			{
+				NumBytes += static_cast<size_t>(Package.GetSummary().TotalHeaderSize);
+			}
+		}
+		const double Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+		std::printf("%zu packages in %.3f s: %.0f packages/s, %.1f MB/s of header\n", NumPackages, Seconds, NumPackages / Seconds, NumBytes / Seconds / (1024.0 * 1024.0));
+		return 0;
+	}
+
+	FDependencyGraph Graph;
+	Graph.Build(Paths, NumThreads, bIncludeScript);
+
+	for (const auto& Failure : Graph.Failures)
+	{
+		std::fprintf(stderr, "%s: %s\n", Failure.first.c_str(), Failure.second.c_str());
+	}
+
+	if (bDump)
+	{
+		for (const FPackageHeader& Package : Graph.Packages)
+		{
+			DumpPackage(Package);
+		}
+	}
+	else if (bDot)
+	{
+		PrintGraphDot(Graph);
+	}
+	else
+	{
+		PrintGraphTsv(Graph);
+	}
+
+	return Graph.Failures.empty() ? 0 : 1;
+}